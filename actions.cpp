@@ -0,0 +1,293 @@
+#include "actions.h"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include "shortcuts.h"
+#include "utils.h"
+
+namespace glfwW
+{
+
+namespace
+{
+
+struct InputName
+{
+    const char* name;
+    Input input;
+};
+
+const InputName INPUT_NAMES[] = {
+    {"MouseLeft", MouseButton::LEFT_BUTTON},
+    {"MouseRight", MouseButton::RIGHT_BUTTON},
+    {"MouseMiddle", MouseButton::MIDDLE_BUTTON},
+    {"Mouse4", MouseButton::BUTTON_4},
+    {"Mouse5", MouseButton::BUTTON_5},
+    {"Mouse6", MouseButton::BUTTON_6},
+    {"Mouse7", MouseButton::BUTTON_7},
+    {"Mouse8", MouseButton::BUTTON_8},
+    {"ScrollX", InputAxis::SCROLL_X},
+    {"ScrollY", InputAxis::SCROLL_Y},
+};
+
+struct ParsedBinding
+{
+    Input input = Key::KEY_UNKNOWN;
+    float scale = 1.0f;
+};
+
+// Parses "Input" or "Input * scale"
+bool parseBinding(const std::string& text, ParsedBinding& binding)
+{
+    const auto star = text.find('*');
+    if(!parseInput(trim(text.substr(0, star)), binding.input))
+    {
+        return false;
+    }
+    binding.scale = 1.0f;
+    if(star == std::string::npos)
+    {
+        return true;
+    }
+    const std::string scale = trim(text.substr(star + 1));
+    char* end = nullptr;
+    binding.scale = std::strtof(scale.c_str(), &end);
+    return !scale.empty() && end == scale.c_str() + scale.size();
+}
+
+}
+
+bool parseInput(const std::string& name, Input& input)
+{
+    for(const auto& entry : INPUT_NAMES)
+    {
+        if(equalNames(name, entry.name))
+        {
+            input = entry.input;
+            return true;
+        }
+    }
+    Key key = Key::KEY_UNKNOWN;
+    if(!parseKey(name, key))
+    {
+        return false;
+    }
+    input = key;
+    return true;
+}
+
+ActionMap::ActionId ActionMap::addAction(const std::string& name)
+{
+    auto itr = m_ids.find(name);
+    if(itr != m_ids.end())
+    {
+        return itr->second;
+    }
+    const auto action = static_cast<ActionId>(m_names.size());
+    m_names.push_back(name);
+    m_ids.emplace(name, action);
+    m_values.push_back(0.0f);
+    m_previousValues.push_back(0.0f);
+    m_compiled = false;
+    return action;
+}
+
+ActionMap::ActionId ActionMap::findAction(const std::string& name) const
+{
+    auto itr = m_ids.find(name);
+    return itr != m_ids.end() ? itr->second : INVALID_ACTION;
+}
+
+const std::string& ActionMap::actionName(ActionId action) const
+{
+    static const std::string empty;
+    return action < m_names.size() ? m_names[action] : empty;
+}
+
+bool ActionMap::bind(ActionId action, Input input, float scale)
+{
+    if(action >= m_names.size() || !input.valid())
+    {
+        return false;
+    }
+    Binding binding;
+    binding.action = action;
+    binding.input = static_cast<uint16_t>(input.index());
+    binding.scale = scale;
+    m_bindings.push_back(binding);
+    m_compiled = false;
+    return true;
+}
+
+void ActionMap::unbind(ActionId action)
+{
+    m_bindings.erase(std::remove_if(m_bindings.begin(), m_bindings.end(), [action](const Binding& binding){
+        return binding.action == action;
+    }), m_bindings.end());
+    m_compiled = false;
+}
+
+void ActionMap::clearBindings()
+{
+    m_bindings.clear();
+    m_compiled = false;
+}
+
+bool ActionMap::loadBindings(std::istream& stream, size_t* errorLine)
+{
+    std::vector<std::pair<std::string, std::vector<ParsedBinding>>> actions;
+    std::string line;
+    size_t lineNumber = 0;
+    while(std::getline(stream, line))
+    {
+        ++lineNumber;
+        line = trim(line.substr(0, line.find('#')));
+        if(line.empty())
+        {
+            continue;
+        }
+
+        const auto equal = line.find('=');
+        const std::string name = trim(line.substr(0, equal));
+        if(equal == std::string::npos || name.empty())
+        {
+            if(errorLine)
+            {
+                *errorLine = lineNumber;
+            }
+            return false;
+        }
+
+        std::vector<ParsedBinding> bindings;
+        std::istringstream inputs(line.substr(equal + 1));
+        std::string text;
+        while(std::getline(inputs, text, ','))
+        {
+            ParsedBinding binding;
+            if(!parseBinding(trim(text), binding))
+            {
+                if(errorLine)
+                {
+                    *errorLine = lineNumber;
+                }
+                return false;
+            }
+            bindings.push_back(binding);
+        }
+        actions.emplace_back(name, std::move(bindings));
+    }
+
+    for(const auto& entry : actions)
+    {
+        const ActionId action = addAction(entry.first);
+        unbind(action);
+        for(const auto& binding : entry.second)
+        {
+            bind(action, binding.input, binding.scale);
+        }
+    }
+    return true;
+}
+
+bool ActionMap::loadBindingsFile(const std::string& path, size_t* errorLine)
+{
+    std::ifstream stream(path);
+    if(!stream)
+    {
+        if(errorLine)
+        {
+            *errorLine = 0;
+        }
+        return false;
+    }
+    return loadBindings(stream, errorLine);
+}
+
+void ActionMap::addScroll(Vec2<double> offset)
+{
+    m_inputs[Input(InputAxis::SCROLL_X).index()] += static_cast<float>(offset.x);
+    m_inputs[Input(InputAxis::SCROLL_Y).index()] += static_cast<float>(offset.y);
+}
+
+void ActionMap::capture(const Window& window)
+{
+    if(!m_compiled)
+    {
+        compile();
+    }
+    for(const auto index : m_polledInputs)
+    {
+        Action action = Action::RELEASE;
+        if(index < static_cast<size_t>(Key::KEY_LAST))
+        {
+            action = window.getKeyAction(static_cast<Key>(index));
+        }
+        else
+        {
+            action = window.getMouseButtonAction(static_cast<MouseButton>(index - static_cast<size_t>(Key::KEY_LAST)));
+        }
+        m_inputs[index] = action == Action::RELEASE ? 0.0f : 1.0f;
+    }
+}
+
+void ActionMap::evaluate()
+{
+    if(!m_compiled)
+    {
+        compile();
+    }
+
+    m_previousValues.swap(m_values);
+    std::fill(m_values.begin(), m_values.end(), 0.0f);
+    const size_t bindingCount = m_bindingActions.size();
+    for(size_t i = 0; i < bindingCount; ++i)
+    {
+        m_values[m_bindingActions[i]] += m_inputs[m_bindingInputs[i]] * m_bindingScales[i];
+    }
+    const size_t actionCount = m_values.size();
+    for(size_t i = 0; i < actionCount; ++i)
+    {
+        m_values[i] = std::min(std::max(m_values[i], m_minValues[i]), m_maxValues[i]);
+    }
+
+    m_inputs[Input(InputAxis::SCROLL_X).index()] = 0.0f;
+    m_inputs[Input(InputAxis::SCROLL_Y).index()] = 0.0f;
+}
+
+void ActionMap::compile()
+{
+    auto bindings = m_bindings;
+    std::stable_sort(bindings.begin(), bindings.end(), [](const Binding& lhs, const Binding& rhs){
+        return lhs.action < rhs.action;
+    });
+
+    m_bindingActions.clear();
+    m_bindingInputs.clear();
+    m_bindingScales.clear();
+    m_polledInputs.clear();
+    m_minValues.assign(m_names.size(), -1.0f);
+    m_maxValues.assign(m_names.size(), 1.0f);
+    for(const auto& binding : bindings)
+    {
+        m_bindingActions.push_back(binding.action);
+        m_bindingInputs.push_back(binding.input);
+        m_bindingScales.push_back(binding.scale);
+        // Axes aren't limited, so a scroll by several steps isn't lost
+        if(binding.input >= Input(InputAxis::SCROLL_X).index())
+        {
+            m_minValues[binding.action] = -std::numeric_limits<float>::infinity();
+            m_maxValues[binding.action] = std::numeric_limits<float>::infinity();
+        }
+        else
+        {
+            m_polledInputs.push_back(binding.input);
+        }
+    }
+    std::sort(m_polledInputs.begin(), m_polledInputs.end());
+    m_polledInputs.erase(std::unique(m_polledInputs.begin(), m_polledInputs.end()), m_polledInputs.end());
+    m_compiled = true;
+}
+
+}
@@ -0,0 +1,185 @@
+#ifndef GLFWW_ACTIONS_H
+#define GLFWW_ACTIONS_H
+
+#include <array>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "defs.h"
+#include "events.h"
+#include "window.h"
+
+namespace glfwW
+{
+
+enum class InputAxis
+{
+    SCROLL_X,
+    SCROLL_Y
+};
+
+/*!
+ * \brief A key, a mouse button or an axis an action can be bound to.
+ * Each input has a dense index, so input values are kept in a flat array.
+ */
+class Input
+{
+public:
+    static constexpr size_t MOUSE_BUTTON_COUNT = 8;
+    static constexpr size_t AXIS_COUNT = 2;
+    static constexpr size_t COUNT = static_cast<size_t>(Key::KEY_LAST) + MOUSE_BUTTON_COUNT + AXIS_COUNT;
+
+    Input(Key key): m_index(static_cast<uint16_t>(key < Key::KEY_LAST ? key : Key::KEY_UNKNOWN)) {}
+    Input(MouseButton button): m_index(static_cast<uint16_t>(MOUSE_BUTTON_BEGIN + static_cast<size_t>(button))) {}
+    Input(InputAxis axis): m_index(static_cast<uint16_t>(AXIS_BEGIN + static_cast<size_t>(axis))) {}
+
+    bool valid() const {return m_index != static_cast<uint16_t>(Key::KEY_UNKNOWN);}
+    bool isKey() const {return m_index < MOUSE_BUTTON_BEGIN;}
+    bool isMouseButton() const {return m_index >= MOUSE_BUTTON_BEGIN && m_index < AXIS_BEGIN;}
+    bool isAxis() const {return m_index >= AXIS_BEGIN;}
+    size_t index() const {return m_index;}
+
+private:
+    static constexpr size_t MOUSE_BUTTON_BEGIN = static_cast<size_t>(Key::KEY_LAST);
+    static constexpr size_t AXIS_BEGIN = MOUSE_BUTTON_BEGIN + MOUSE_BUTTON_COUNT;
+
+    uint16_t m_index = 0;
+};
+
+/*!
+ * \brief Parses an input name: a key name accepted by parseKey, MouseLeft, MouseRight, MouseMiddle, Mouse4 - Mouse8,
+ * ScrollX or ScrollY. Names are case-insensitive.
+ */
+bool parseInput(const std::string& name, Input& input);
+
+/*!
+ * \brief Maps named actions to inputs. Game logic reads action values instead of checking keys and buttons.
+ * Each action value is the sum of its bound input values multiplied by the binding scales, so e.g. W bound with
+ * scale 1 and S bound with scale -1 compose into a movement axis. Values of actions bound only to keys and
+ * mouse buttons are clamped to [-1, 1].
+ * Bindings are compiled into flat arrays sorted by action, and evaluate() computes all values in one pass
+ * without branching over input devices. Inputs of other devices (e.g. gamepads) can be fed with setInput().
+ */
+class ActionMap
+{
+public:
+    using ActionId = uint32_t;
+
+    static constexpr ActionId INVALID_ACTION = UINT32_MAX;
+
+    /*!
+     * \brief Adds an action and returns its id. Ids are dense and start at 0.
+     * Returns the id of the existing action if there is one with this name.
+     */
+    ActionId addAction(const std::string& name);
+
+    /*!
+     * \brief Returns the id of the action or INVALID_ACTION.
+     */
+    ActionId findAction(const std::string& name) const;
+
+    const std::string& actionName(ActionId action) const;
+
+    size_t actionCount() const {return m_names.size();}
+
+    bool bind(ActionId action, Input input, float scale = 1.0f);
+
+    /*!
+     * \brief Removes all bindings of the action.
+     */
+    void unbind(ActionId action);
+
+    void clearBindings();
+
+    size_t bindingCount() const {return m_bindings.size();}
+
+    /*!
+     * \brief Loads bindings, one action per line:
+     *
+     *     # comment
+     *     Jump = Space, MouseRight
+     *     MoveForward = W, Up, S * -1, Down * -1
+     *     Zoom = ScrollY * 0.5
+     *
+     * Actions are added if needed, and the listed actions lose their previous bindings.
+     * Nothing is changed if the stream has an error; errorLine then gets the number of the invalid line.
+     */
+    bool loadBindings(std::istream& stream, size_t* errorLine = nullptr);
+    bool loadBindingsFile(const std::string& path, size_t* errorLine = nullptr);
+
+    /*!
+     * \brief Sets the value of an input. Keys and buttons are 1 when pressed, axes have any value.
+     */
+    void setInput(Input input, float value) {m_inputs[input.index()] = value;}
+
+    float input(Input input) const {return m_inputs[input.index()];}
+
+    /*!
+     * \brief Accumulates scroll offsets until the next evaluation, e.g. from a Window::ScrollHandler.
+     */
+    void addScroll(Vec2<double> offset);
+
+    /*!
+     * \brief Reads the states of the bound keys and mouse buttons of the window.
+     */
+    void capture(const Window& window);
+
+    /*!
+     * \brief Computes the action values from the input values. Scroll axes are reset afterwards.
+     */
+    void evaluate();
+
+    /*!
+     * \brief Captures the inputs of the window and evaluates the actions. Called once per frame.
+     */
+    void update(const Window& window)
+    {
+        capture(window);
+        evaluate();
+    }
+
+    float value(ActionId action) const {return m_values[action];}
+    float operator[](ActionId action) const {return m_values[action];}
+
+    bool active(ActionId action) const {return m_values[action] != 0.0f;}
+
+    /*!
+     * \brief Returns true if the action became active in the last evaluation.
+     */
+    bool triggered(ActionId action) const {return m_values[action] != 0.0f && m_previousValues[action] == 0.0f;}
+
+    Span<const float> values() const {return Span<const float>(m_values.data(), m_values.size());}
+
+private:
+    struct Binding
+    {
+        ActionId action = 0;
+        uint16_t input = 0;
+        float scale = 1.0f;
+    };
+
+    void compile();
+
+    std::vector<std::string> m_names;
+    std::unordered_map<std::string, ActionId> m_ids;
+    std::vector<Binding> m_bindings;
+    bool m_compiled = true;
+
+    // Compiled bindings as parallel arrays sorted by action
+    std::vector<ActionId> m_bindingActions;
+    std::vector<uint16_t> m_bindingInputs;
+    std::vector<float> m_bindingScales;
+    std::vector<uint16_t> m_polledInputs;
+    std::vector<float> m_minValues;
+    std::vector<float> m_maxValues;
+
+    std::array<float, Input::COUNT> m_inputs = {};
+    std::vector<float> m_values;
+    std::vector<float> m_previousValues;
+};
+
+}
+
+#endif
@@ -0,0 +1,56 @@
+#include "bench.h"
+#include "../actions.h"
+
+namespace glfwW
+{
+
+namespace bench
+{
+
+namespace
+{
+
+constexpr uint64_t EVALUATION_COUNT = 1000;
+// Keys are picked from the first KEY_RANGE key indices
+constexpr int KEY_RANGE = 100;
+
+void benchmarkActionCount(int actionCount)
+{
+    ActionMap map;
+    for(int i = 0; i < actionCount; ++i)
+    {
+        const auto action = map.addAction("action" + std::to_string(i));
+        map.bind(action, static_cast<Key>(1 + i % KEY_RANGE));
+        map.bind(action, static_cast<Key>(1 + (i * 7) % KEY_RANGE), -0.5f);
+    }
+    for(int key = 1; key <= KEY_RANGE; key += 3)
+    {
+        map.setInput(static_cast<Key>(key), 1.0f);
+    }
+    // The first evaluation compiles the bindings
+    map.evaluate();
+
+    Stopwatch stopwatch;
+    for(uint64_t i = 0; i < EVALUATION_COUNT; ++i)
+    {
+        map.evaluate();
+    }
+    const double seconds = stopwatch.seconds();
+    report("evaluate " + std::to_string(actionCount) + " actions", EVALUATION_COUNT, seconds);
+    report("  per action", EVALUATION_COUNT * static_cast<uint64_t>(actionCount), seconds);
+    consume(static_cast<uint64_t>(map[0] * 2.0f));
+}
+
+}
+
+void benchmarkActions()
+{
+    for(const int actionCount : {100, 1000, 5000, 20000})
+    {
+        benchmarkActionCount(actionCount);
+    }
+}
+
+}
+
+}
@@ -0,0 +1,57 @@
+#ifndef GLFWW_BENCH_H
+#define GLFWW_BENCH_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace glfwW
+{
+
+namespace bench
+{
+
+/*!
+ * \brief Measures the time since its construction or the last restart
+ */
+class Stopwatch
+{
+public:
+    void restart() {m_start = std::chrono::steady_clock::now();}
+
+    double seconds() const
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point m_start = std::chrono::steady_clock::now();
+};
+
+/*!
+ * \brief Prints the time per operation and the number of operations per second
+ */
+void report(const std::string& name, uint64_t operations, double seconds);
+
+/*!
+ * \brief Keeps a computed value observable, so the measured work isn't optimized away
+ */
+void consume(uint64_t value);
+
+/*!
+ * \brief Initializes GLFWlibrary if it isn't yet. Falls back to the null platform where GLFW supports it,
+ * so benchmarks run without a display. Returns false and prints the error if GLFW can't be initialized.
+ */
+bool initLibrary();
+
+void benchmarkStartup();
+void benchmarkDispatch();
+void benchmarkHistogram();
+void benchmarkActions();
+void benchmarkOffscreen();
+
+}
+
+}
+
+#endif
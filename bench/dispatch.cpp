@@ -0,0 +1,90 @@
+#include "bench.h"
+#include <iostream>
+#include "../glfwlibrary.h"
+#include "../utils.h"
+
+namespace glfwW
+{
+
+namespace bench
+{
+
+namespace
+{
+
+constexpr uint64_t EVENT_COUNT = 10000000;
+
+}
+
+void benchmarkDispatch()
+{
+    if(!initLibrary())
+    {
+        return;
+    }
+
+    // Events are fed to the wrapper's GLFW callbacks directly, so only the wrapper's share of the dispatch is measured
+    WindowCreationHints hints;
+    hints.addHint<WindowHint::VISIBLE>(false).addHint<WindowHint::CLIENT_API>(ClientAPI::NO_API);
+    Window window = GLFWlibrary::instance().createWindow(hints, {64, 64}, "glfwW dispatch benchmark");
+    if(!window.valid())
+    {
+        std::cout << "  window creation failed\n";
+        return;
+    }
+    GLFWwindow* handle = window.getHandler();
+
+    uint64_t checksum = 0;
+    window.setKeyHandler([&checksum](const Window&, KeyEvent event){
+        checksum += static_cast<uint64_t>(event.key) + static_cast<uint64_t>(event.action);
+    });
+    window.setMouseClickHandler([&checksum](const Window&, MouseButtonEvent event){
+        checksum += static_cast<uint64_t>(event.button) + static_cast<uint64_t>(event.action);
+    });
+    window.setCursorPositionChangesHandler([&checksum](const Window&, Vec2<double> position){
+        checksum += static_cast<uint64_t>(position.x);
+    });
+
+    Stopwatch stopwatch;
+    for(uint64_t i = 0; i < EVENT_COUNT; ++i)
+    {
+        keyCallback(handle, GLFW_KEY_A + static_cast<int>(i % 26), 0, static_cast<int>(i % 3), 0);
+    }
+    report("key event", EVENT_COUNT, stopwatch.seconds());
+
+    stopwatch.restart();
+    for(uint64_t i = 0; i < EVENT_COUNT; ++i)
+    {
+        mouseButtonCallback(handle, static_cast<int>(i % 8), static_cast<int>(i % 2), 0);
+    }
+    report("mouse button event", EVENT_COUNT, stopwatch.seconds());
+
+    stopwatch.restart();
+    for(uint64_t i = 0; i < EVENT_COUNT; ++i)
+    {
+        cursorPositionCallback(handle, static_cast<double>(i % 1024), 0.0);
+    }
+    report("cursor position event", EVENT_COUNT, stopwatch.seconds());
+
+    stopwatch.restart();
+    for(uint64_t i = 0; i < EVENT_COUNT; ++i)
+    {
+        checksum += static_cast<uint64_t>(fromGlfwKey(GLFW_KEY_A + static_cast<int>(i % 26))) +
+                    static_cast<uint64_t>(fromGlfwAction(static_cast<int>(i % 3))) +
+                    static_cast<uint64_t>(fromGlfwMouseButton(static_cast<int>(i % 8))) + fromGLFWBool(static_cast<int>(i % 2));
+    }
+    report("event conversions", EVENT_COUNT, stopwatch.seconds());
+
+    stopwatch.restart();
+    for(uint64_t i = 0; i < EVENT_COUNT; ++i)
+    {
+        checksum += static_cast<uint64_t>(window.getKeyAction(Key::KEY_A)) + static_cast<uint64_t>(window.getCursorMode());
+    }
+    report("key and cursor mode queries", EVENT_COUNT, stopwatch.seconds());
+
+    consume(checksum);
+}
+
+}
+
+}
@@ -0,0 +1,74 @@
+#include "bench.h"
+#include <functional>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "../histogram.h"
+
+namespace glfwW
+{
+
+namespace bench
+{
+
+namespace
+{
+
+constexpr uint64_t SAMPLE_COUNT = 100000000;
+constexpr unsigned THREAD_COUNT = 4;
+
+// Durations of about 1 us - 1 ms in nanoseconds, spread over the buckets like real timings
+uint64_t nextSample(uint64_t& state)
+{
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return 1000 + (state & 0xFFFFF);
+}
+
+void record(Histogram& histogram, uint64_t count, uint64_t seed)
+{
+    uint64_t state = seed;
+    for(uint64_t i = 0; i < count; ++i)
+    {
+        histogram.record(nextSample(state));
+    }
+}
+
+}
+
+void benchmarkHistogram()
+{
+    Histogram histogram;
+
+    Stopwatch stopwatch;
+    record(histogram, SAMPLE_COUNT, 0x9E3779B97F4A7C15ull);
+    report("record, 1 thread", SAMPLE_COUNT, stopwatch.seconds());
+
+    histogram.reset();
+    std::vector<std::thread> threads;
+    stopwatch.restart();
+    for(unsigned i = 0; i < THREAD_COUNT; ++i)
+    {
+        threads.emplace_back(record, std::ref(histogram), SAMPLE_COUNT / THREAD_COUNT, 0x9E3779B97F4A7C15ull + i);
+    }
+    for(auto& thread : threads)
+    {
+        thread.join();
+    }
+    report("record, " + std::to_string(THREAD_COUNT) + " threads sharing a histogram, wall time", SAMPLE_COUNT, stopwatch.seconds());
+
+    HistogramSnapshot snapshot;
+    stopwatch.restart();
+    histogram.snapshot(snapshot);
+    const uint64_t p50 = snapshot.percentile(50.0);
+    const uint64_t p99 = snapshot.percentile(99.0);
+    const uint64_t p999 = snapshot.percentile(99.9);
+    report("snapshot and 3 percentiles", 1, stopwatch.seconds());
+    std::cout << "  samples " << snapshot.count() << ", p50 " << p50 << ", p99 " << p99 << ", p99.9 " << p999 << "\n";
+    consume(p50 + p99 + p999);
+}
+
+}
+
+}
@@ -0,0 +1,101 @@
+#include "bench.h"
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include "../glfwlibrary.h"
+
+namespace glfwW
+{
+
+namespace bench
+{
+
+namespace
+{
+
+volatile uint64_t sink = 0;
+
+struct Benchmark
+{
+    const char* name;
+    void(* run)();
+};
+
+// Startup goes first, since it measures the initialization of GLFW
+const Benchmark BENCHMARKS[] = {
+    {"startup", benchmarkStartup},
+    {"dispatch", benchmarkDispatch},
+    {"histogram", benchmarkHistogram},
+    {"actions", benchmarkActions},
+    {"offscreen", benchmarkOffscreen},
+};
+
+}
+
+void report(const std::string& name, uint64_t operations, double seconds)
+{
+    const double nanoseconds = operations ? seconds * 1e9 / static_cast<double>(operations) : 0.0;
+    const double rate = seconds > 0.0 ? static_cast<double>(operations) / seconds : 0.0;
+    std::cout << "  " << name << ": " << std::fixed << std::setprecision(2) << nanoseconds << " ns/op, "
+              << std::setprecision(0) << rate << " op/s (" << operations << " ops in " << std::setprecision(3)
+              << seconds << " s)\n" << std::defaultfloat;
+}
+
+void consume(uint64_t value)
+{
+    sink = sink + value;
+}
+
+bool initLibrary()
+{
+    auto& lib = GLFWlibrary::instance();
+    if(lib.initialized())
+    {
+        return true;
+    }
+
+    GLFWlibrary::InitHints hints;
+    hints.fallbackPlatforms = {Platform::NULL_PLATFORM};
+    const Error error = lib.init(hints);
+    if(error.code != ErrorCode::NO_ERROR)
+    {
+        std::cout << "  GLFW initialization failed: " << error.description << "\n";
+        return false;
+    }
+    return true;
+}
+
+}
+
+}
+
+// Runs the benchmarks named on the command line, or all of them.
+// Configure with GLFWW_INLINE_HOT_PATH on and off to compare the inline and out-of-line builds.
+// Dispatch timings differ only by the event conversions, dispatch itself is always compiled into the library.
+int main(int argc, char** argv)
+{
+    using namespace glfwW::bench;
+
+#ifdef GLFWW_INLINE_HOT_PATH
+    std::cout << "hot path: inline\n";
+#else
+    std::cout << "hot path: out-of-line\n";
+#endif
+
+    for(const auto& benchmark : BENCHMARKS)
+    {
+        bool selected = argc < 2;
+        for(int i = 1; i < argc; ++i)
+        {
+            selected = selected || std::strcmp(argv[i], benchmark.name) == 0;
+        }
+        if(selected)
+        {
+            std::cout << benchmark.name << "\n";
+            benchmark.run();
+        }
+    }
+
+    glfwW::GLFWlibrary::instance().deinit();
+    return 0;
+}
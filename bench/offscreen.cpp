@@ -0,0 +1,89 @@
+#include "bench.h"
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "../glfwlibrary.h"
+
+namespace glfwW
+{
+
+namespace bench
+{
+
+namespace
+{
+
+// Every resolution renders for at least this long and at least MIN_FRAMES frames
+constexpr double MIN_SECONDS = 1.0;
+constexpr uint64_t MIN_FRAMES = 10;
+
+void reportFps(const std::string& name, uint64_t frames, double seconds)
+{
+    std::cout << "  " << name << ": " << std::fixed << std::setprecision(1) << frames / seconds << " fps, "
+              << std::setprecision(3) << seconds * 1000.0 / frames << " ms/frame\n" << std::defaultfloat;
+}
+
+bool benchmarkResolution(Vec2<int> size)
+{
+    Window window = GLFWlibrary::instance().createOffscreenWindow(size);
+    if(!window.valid())
+    {
+        std::cout << "  offscreen context creation failed\n";
+        return false;
+    }
+    window.activate();
+    glViewport(0, 0, size.x, size.y);
+
+    const std::string resolution = std::to_string(size.x) + "x" + std::to_string(size.y);
+    std::vector<unsigned char> pixels(window.getFramebufferByteSize(PixelFormat::RGBA));
+
+    // Rendering is a clear with a changing color, so the readback dominates at large resolutions
+    uint64_t frames = 0;
+    Stopwatch stopwatch;
+    while(frames < MIN_FRAMES || stopwatch.seconds() < MIN_SECONDS)
+    {
+        glClearColor(static_cast<float>(frames % 256) / 255.0f, 0.5f, 0.25f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glFinish();
+        ++frames;
+    }
+    reportFps(resolution + " render", frames, stopwatch.seconds());
+
+    frames = 0;
+    stopwatch.restart();
+    while(frames < MIN_FRAMES || stopwatch.seconds() < MIN_SECONDS)
+    {
+        glClearColor(static_cast<float>(frames % 256) / 255.0f, 0.5f, 0.25f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+        if(!window.readPixels(PixelFormat::RGBA, pixels.data(), pixels.size()))
+        {
+            std::cout << "  " << resolution << " readback failed\n";
+            return false;
+        }
+        ++frames;
+    }
+    reportFps(resolution + " render and readback", frames, stopwatch.seconds());
+    consume(pixels.empty() ? 0 : pixels[0]);
+    return true;
+}
+
+}
+
+void benchmarkOffscreen()
+{
+    if(!initLibrary())
+    {
+        return;
+    }
+    for(const Vec2<int> size : {Vec2<int>{256, 256}, Vec2<int>{1280, 720}, Vec2<int>{1920, 1080}, Vec2<int>{3840, 2160}})
+    {
+        if(!benchmarkResolution(size))
+        {
+            return;
+        }
+    }
+}
+
+}
+
+}
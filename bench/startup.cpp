@@ -0,0 +1,73 @@
+#include "bench.h"
+#include <iomanip>
+#include <iostream>
+#include "../glfwlibrary.h"
+
+namespace glfwW
+{
+
+namespace bench
+{
+
+namespace
+{
+
+const char* warmUpName(MonitorWarmUp warmUp)
+{
+    switch(warmUp)
+    {
+    case MonitorWarmUp::LAZY:
+        return "lazy";
+    case MonitorWarmUp::IMMEDIATE:
+        return "immediate";
+    case MonitorWarmUp::DEFERRED:
+        return "deferred";
+    }
+    return "";
+}
+
+void benchmarkStartupWith(MonitorWarmUp warmUp)
+{
+    auto& lib = GLFWlibrary::instance();
+    lib.deinit();
+
+    GLFWlibrary::InitHints hints;
+    hints.fallbackPlatforms = {Platform::NULL_PLATFORM};
+    hints.monitorWarmUp = warmUp;
+
+    Stopwatch stopwatch;
+    const Error error = lib.init(hints);
+    if(error.code != ErrorCode::NO_ERROR)
+    {
+        std::cout << "  GLFW initialization failed: " << error.description << "\n";
+        return;
+    }
+
+    WindowCreationHints windowHints;
+    windowHints.addHint<WindowHint::VISIBLE>(false);
+    Window window = lib.createWindow(windowHints, {640, 480}, "glfwW startup benchmark");
+    // A deferred warm-up runs during the first event processing
+    lib.pollEvents();
+    const double total = stopwatch.seconds();
+
+    const auto& timings = lib.startupTimings();
+    std::cout << "  " << warmUpName(warmUp) << " monitor warm-up: " << std::fixed << std::setprecision(3)
+              << "init " << timings.init * 1000.0 << " ms, monitor warm-up " << timings.monitorWarmUp * 1000.0
+              << " ms, first window " << timings.firstWindow * 1000.0 << " ms, until first events processed "
+              << total * 1000.0 << " ms" << (window.valid() ? "" : " (window creation failed)") << "\n"
+              << std::defaultfloat;
+}
+
+}
+
+void benchmarkStartup()
+{
+    for(const auto warmUp : {MonitorWarmUp::LAZY, MonitorWarmUp::IMMEDIATE, MonitorWarmUp::DEFERRED})
+    {
+        benchmarkStartupWith(warmUp);
+    }
+}
+
+}
+
+}
@@ -0,0 +1,180 @@
+#include "capture.h"
+
+namespace glfwW
+{
+
+FrameCapture::FrameCapture(CaptureSettings settings, OutputHandler handler):
+      m_settings(settings), m_outputHandler(handler)
+{
+    m_settings.workerCount = std::max(m_settings.workerCount, 1);
+    m_settings.maxPendingFrames = std::max<size_t>(m_settings.maxPendingFrames, 1);
+    for(int i = 0; i < m_settings.workerCount; ++i)
+    {
+        m_workers.emplace_back(&FrameCapture::workerLoop, this);
+    }
+}
+
+FrameCapture::~FrameCapture()
+{
+    finish();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_frameAvailable.notify_all();
+    for(auto& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+bool FrameCapture::submit(Frame&& frame)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if(m_pending.size() >= m_settings.maxPendingFrames)
+    {
+        switch(m_settings.dropPolicy)
+        {
+        case DropPolicy::DROP_NEWEST:
+            ++m_droppedFrames;
+            return false;
+        case DropPolicy::DROP_OLDEST:
+            ++m_droppedFrames;
+            if(m_storage.size() < m_settings.maxPendingFrames + m_workers.size())
+            {
+                m_storage.push_back(std::move(m_pending.front().pixels));
+            }
+            m_pending.pop_front();
+            break;
+        case DropPolicy::BLOCK:
+            m_spaceAvailable.wait(lock, [this]{
+                return m_pending.size() < m_settings.maxPendingFrames;
+            });
+            break;
+        }
+    }
+    m_pending.push_back(std::move(frame));
+    lock.unlock();
+    m_frameAvailable.notify_one();
+    return true;
+}
+
+void FrameCapture::capture(AsyncReadback& readback)
+{
+    Frame frame;
+    while(readback.tryPopFrame(frame))
+    {
+        if(!submit(std::move(frame)))
+        {
+            readback.recycle(std::move(frame));
+        }
+        frame = Frame();
+    }
+
+    std::vector<unsigned char> storage;
+    while(reclaimStorage(storage))
+    {
+        Frame recycled;
+        recycled.pixels = std::move(storage);
+        readback.recycle(std::move(recycled));
+    }
+}
+
+bool FrameCapture::reclaimStorage(std::vector<unsigned char>& storage)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(m_storage.empty())
+    {
+        return false;
+    }
+    storage = std::move(m_storage.back());
+    m_storage.pop_back();
+    return true;
+}
+
+void FrameCapture::finish()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this]{
+        return m_pending.empty() && m_activeWorkers == 0;
+    });
+}
+
+uint64_t FrameCapture::droppedFrames() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_droppedFrames;
+}
+
+void FrameCapture::workerLoop()
+{
+    std::vector<unsigned char> encoded;
+    while(true)
+    {
+        Frame frame;
+        uint64_t sequence = 0;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_frameAvailable.wait(lock, [this]{
+                return m_stopping || !m_pending.empty();
+            });
+            if(m_pending.empty())
+            {
+                return;
+            }
+            frame = std::move(m_pending.front());
+            m_pending.pop_front();
+            // Sequence numbers are given on dequeue, so frames dropped from the queue leave no gaps
+            sequence = m_nextSequence++;
+            ++m_activeWorkers;
+        }
+        m_spaceAvailable.notify_one();
+
+        encodeFrame(m_settings.format, frame, m_settings.flipVertically, encoded);
+        deliver(sequence, std::move(frame), std::move(encoded));
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_activeWorkers;
+        }
+        m_idle.notify_all();
+
+        std::lock_guard<std::mutex> lock(m_outputMutex);
+        encoded.clear();
+        if(!m_outputBuffers.empty())
+        {
+            encoded = std::move(m_outputBuffers.back());
+            m_outputBuffers.pop_back();
+        }
+    }
+}
+
+void FrameCapture::deliver(uint64_t sequence, Frame&& frame, std::vector<unsigned char>&& encoded)
+{
+    std::lock_guard<std::mutex> lock(m_outputMutex);
+    m_completed.emplace(sequence, std::make_pair(std::move(frame), std::move(encoded)));
+
+    for(auto itr = m_completed.find(m_nextDelivery); itr != m_completed.end(); itr = m_completed.find(m_nextDelivery))
+    {
+        if(m_outputHandler)
+        {
+            std::invoke(m_outputHandler, itr->second.first, itr->second.second);
+        }
+        recycleStorage(std::move(itr->second.first.pixels));
+        m_outputBuffers.push_back(std::move(itr->second.second));
+        m_completed.erase(itr);
+        ++m_nextDelivery;
+    }
+}
+
+void FrameCapture::recycleStorage(std::vector<unsigned char>&& storage)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // Storage nobody reclaims is released instead of piling up
+    if(m_storage.size() < m_settings.maxPendingFrames + m_workers.size())
+    {
+        m_storage.push_back(std::move(storage));
+    }
+}
+
+}
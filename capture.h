@@ -0,0 +1,117 @@
+#ifndef GLFWW_CAPTURE_H
+#define GLFWW_CAPTURE_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "encoders.h"
+#include "readback.h"
+
+namespace glfwW
+{
+
+/*!
+ * \brief What happens to a frame submitted while the encoders are behind
+ */
+enum class DropPolicy
+{
+    DROP_NEWEST,
+    DROP_OLDEST,
+    BLOCK
+};
+
+struct CaptureSettings
+{
+    CaptureFormat format = CaptureFormat::PNG;
+    /*!
+     * \brief Number of encoding threads
+     */
+    int workerCount = 2;
+    /*!
+     * \brief Maximum number of frames waiting for a worker. Frames beyond it are handled by the drop policy.
+     */
+    size_t maxPendingFrames = 4;
+    DropPolicy dropPolicy = DropPolicy::DROP_NEWEST;
+    /*!
+     * \brief Frames read back from OpenGL are stored bottom-up, flipping makes images top-down.
+     */
+    bool flipVertically = true;
+};
+
+/*!
+ * \brief Encodes captured frames on a pool of worker threads.
+ * Submitting a frame only moves it into a bounded queue, so capture costs the render thread almost nothing.
+ * Encoded frames are passed to the output handler in submission order, one at a time, from a worker thread.
+ */
+class FrameCapture
+{
+public:
+    using OutputHandler = std::function<void(const Frame&, const std::vector<unsigned char>&)>;
+
+    FrameCapture(CaptureSettings settings, OutputHandler handler);
+    FrameCapture(const FrameCapture&) = delete;
+    FrameCapture& operator=(const FrameCapture&) = delete;
+    ~FrameCapture();
+
+    /*!
+     * \brief Queues a frame for encoding. The frame's pixels are moved, not copied.
+     * Returns false if the frame was dropped by the DROP_NEWEST policy, in which case it is left untouched.
+     */
+    bool submit(Frame&& frame);
+
+    /*!
+     * \brief Takes all frames queued by the readback and returns the storage of already encoded frames to it.
+     * Has to be called on the readback's thread.
+     */
+    void capture(AsyncReadback& readback);
+
+    /*!
+     * \brief Takes back pixel storage of an encoded frame. Returns false if there is none.
+     */
+    bool reclaimStorage(std::vector<unsigned char>& storage);
+
+    /*!
+     * \brief Blocks until all queued frames have been encoded and delivered.
+     */
+    void finish();
+
+    /*!
+     * \brief Returns the number of frames dropped because the workers fell behind.
+     */
+    uint64_t droppedFrames() const;
+
+private:
+    void workerLoop();
+    void deliver(uint64_t sequence, Frame&& frame, std::vector<unsigned char>&& encoded);
+    void recycleStorage(std::vector<unsigned char>&& storage);
+
+    CaptureSettings m_settings;
+    OutputHandler m_outputHandler;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_frameAvailable;
+    std::condition_variable m_spaceAvailable;
+    std::condition_variable m_idle;
+    std::deque<Frame> m_pending;
+    std::vector<std::vector<unsigned char>> m_storage;
+    uint64_t m_nextSequence = 0;
+    uint64_t m_droppedFrames = 0;
+    int m_activeWorkers = 0;
+    bool m_stopping = false;
+
+    std::mutex m_outputMutex;
+    std::map<uint64_t, std::pair<Frame, std::vector<unsigned char>>> m_completed;
+    std::vector<std::vector<unsigned char>> m_outputBuffers;
+    uint64_t m_nextDelivery = 0;
+
+    std::vector<std::thread> m_workers;
+};
+
+}
+
+#endif
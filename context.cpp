@@ -0,0 +1,86 @@
+#include "context.h"
+#include <atomic>
+#include <cassert>
+#include "window.h"
+
+namespace glfwW
+{
+
+namespace
+{
+
+// Incremented when all contexts are gone, so every thread looks its context up again
+std::atomic<unsigned> trackingGeneration = {1};
+
+struct TrackedContext
+{
+    GLFWwindow* window = nullptr;
+    // The context current before the thread first used the wrapper is looked up once per generation
+    unsigned generation = 0;
+};
+
+thread_local TrackedContext trackedContext;
+
+TrackedContext& tracked()
+{
+    const unsigned generation = trackingGeneration.load(std::memory_order_relaxed);
+    if(trackedContext.generation != generation)
+    {
+        trackedContext.window = glfwGetCurrentContext();
+        trackedContext.generation = generation;
+    }
+    return trackedContext;
+}
+
+}
+
+GLFWwindow* currentContext()
+{
+    auto& context = tracked();
+    assert(context.window == glfwGetCurrentContext() && "The current context was changed bypassing the wrapper");
+    return context.window;
+}
+
+bool makeContextCurrent(GLFWwindow* window)
+{
+    auto& context = tracked();
+    if(context.window == window)
+    {
+        return false;
+    }
+    glfwMakeContextCurrent(window);
+    // The call fails e.g. for a window without a context, and may leave no context current
+    context.window = glfwGetCurrentContext();
+    return true;
+}
+
+void onContextDestroyed(GLFWwindow* window)
+{
+    auto& context = tracked();
+    if(context.window == window)
+    {
+        context.window = nullptr;
+    }
+}
+
+void resetContextTracking()
+{
+    trackingGeneration.fetch_add(1, std::memory_order_relaxed);
+}
+
+ContextGuard::ContextGuard(GLFWwindow* window):
+      m_previous(currentContext())
+{
+    makeContextCurrent(window);
+}
+
+ContextGuard::ContextGuard(const Window& window):
+      ContextGuard(window.getHandler())
+{}
+
+ContextGuard::~ContextGuard()
+{
+    makeContextCurrent(m_previous);
+}
+
+}
@@ -0,0 +1,62 @@
+#ifndef GLFWW_CONTEXT_H
+#define GLFWW_CONTEXT_H
+
+#include "defs.h"
+
+namespace glfwW
+{
+
+class Window;
+
+/*!
+ * \brief Returns the context current on the calling thread.
+ * The wrapper tracks the current context per thread, so this doesn't call into GLFW.
+ * ! Contexts have to be made current through the wrapper. Debug builds assert that the tracked context matches GLFW's.
+ */
+GLFWwindow* currentContext();
+
+/*!
+ * \brief Makes the window's context current on the calling thread unless it already is. Null detaches the current context.
+ * Returns true if glfwMakeContextCurrent was called.
+ */
+bool makeContextCurrent(GLFWwindow* window);
+
+/*!
+ * \brief Returns true if the window's context is current on the calling thread.
+ */
+inline bool isContextCurrent(GLFWwindow* window)
+{
+    return window && currentContext() == window;
+}
+
+/*!
+ * \brief Has to be called when a window is destroyed, since GLFW detaches its context if it is current.
+ */
+void onContextDestroyed(GLFWwindow* window);
+
+/*!
+ * \brief Makes every thread look its current context up again. Has to be called when GLFW is terminated,
+ * since that destroys all contexts and new windows may get the addresses of the destroyed ones.
+ */
+void resetContextTracking();
+
+/*!
+ * \brief Makes a context current for its lifetime and restores the previously current one afterwards.
+ * ! The previously current window has to outlive the guard.
+ */
+class ContextGuard
+{
+public:
+    explicit ContextGuard(GLFWwindow* window);
+    explicit ContextGuard(const Window& window);
+    ContextGuard(const ContextGuard&) = delete;
+    ContextGuard& operator=(const ContextGuard&) = delete;
+    ~ContextGuard();
+
+private:
+    GLFWwindow* m_previous = nullptr;
+};
+
+}
+
+#endif
@@ -0,0 +1,68 @@
+#include "coroutine.h"
+
+#ifdef GLFWW_HAS_COROUTINES
+
+#include <algorithm>
+#include "glfwlibrary.h"
+
+namespace glfwW
+{
+
+Coroutine& Coroutine::operator=(Coroutine&& rhs) noexcept
+{
+    if(this != &rhs)
+    {
+        if(m_handle)
+        {
+            m_handle.destroy();
+        }
+        m_handle = rhs.m_handle;
+        rhs.m_handle = nullptr;
+    }
+    return *this;
+}
+
+void EventLoopExecutor::spawn(Coroutine coroutine)
+{
+    if(coroutine.done())
+    {
+        return;
+    }
+    auto handle = coroutine.m_handle;
+    m_coroutines.push_back(std::move(coroutine));
+    handle.resume();
+    collectFinished();
+}
+
+void EventLoopExecutor::runOnce()
+{
+    auto& library = GLFWlibrary::instance();
+    if(library.hasFrameWaiters())
+    {
+        library.pollEvents();
+    }
+    else
+    {
+        library.waitEvents();
+    }
+    collectFinished();
+}
+
+void EventLoopExecutor::run()
+{
+    while(!empty())
+    {
+        runOnce();
+    }
+}
+
+void EventLoopExecutor::collectFinished()
+{
+    m_coroutines.erase(std::remove_if(m_coroutines.begin(), m_coroutines.end(), [](const Coroutine& coroutine){
+        return coroutine.done();
+    }), m_coroutines.end());
+}
+
+}
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef GLFWW_COROUTINE_H
+#define GLFWW_COROUTINE_H
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define GLFWW_HAS_COROUTINES
+#endif
+#endif
+
+#ifdef GLFWW_HAS_COROUTINES
+
+#include <coroutine>
+#include <exception>
+#include <vector>
+
+namespace glfwW
+{
+
+class EventLoopExecutor;
+
+/*!
+ * \brief A fire-and-forget coroutine run by an EventLoopExecutor, e.g. a UI flow awaiting window events.
+ * Only the coroutine frame is allocated; awaiting events of Window and GLFWlibrary doesn't allocate.
+ */
+class Coroutine
+{
+public:
+    struct promise_type
+    {
+        Coroutine get_return_object()
+        {
+            return Coroutine(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept {return {};}
+        std::suspend_always final_suspend() noexcept {return {};}
+        void return_void() {}
+        void unhandled_exception() {std::terminate();}
+    };
+
+    Coroutine(const Coroutine&) = delete;
+    Coroutine& operator=(const Coroutine&) = delete;
+    Coroutine(Coroutine&& rhs) noexcept: m_handle(rhs.m_handle) {rhs.m_handle = nullptr;}
+    Coroutine& operator=(Coroutine&& rhs) noexcept;
+
+    ~Coroutine()
+    {
+        if(m_handle)
+        {
+            m_handle.destroy();
+        }
+    }
+
+    bool done() const {return !m_handle || m_handle.done();}
+
+private:
+    friend class EventLoopExecutor;
+
+    explicit Coroutine(std::coroutine_handle<promise_type> handle): m_handle(handle) {}
+
+    std::coroutine_handle<promise_type> m_handle;
+};
+
+/*!
+ * \brief A single-threaded executor driving coroutines through the event loop of GLFWlibrary.
+ * Coroutines are resumed from event dispatch; the executor only processes events and destroys finished coroutines.
+ * It has to be used on the main thread.
+ */
+class EventLoopExecutor
+{
+public:
+    /*!
+     * \brief Starts the coroutine. It runs until its first suspension before spawn() returns.
+     */
+    void spawn(Coroutine coroutine);
+
+    bool empty() const {return m_coroutines.empty();}
+
+    /*!
+     * \brief Processes events once. Polls if a coroutine awaits the next frame, otherwise waits for events.
+     */
+    void runOnce();
+
+    /*!
+     * \brief Processes events until all coroutines have finished.
+     */
+    void run();
+
+private:
+    void collectFinished();
+
+    std::vector<Coroutine> m_coroutines;
+};
+
+}
+
+#endif
+
+#endif
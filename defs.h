@@ -1,8 +1,23 @@
 #ifndef GLFWW_DEFS_H
 #define GLFWW_DEFS_H
 
+#include <cstddef>
 #include <GLFW/glfw3.h>
 
+/*!
+ * GLFWW_INLINE_HOT_PATH defines small conversion and query functions called on every event inline in the headers
+ * (the .inl files), so they can be inlined without LTO. Otherwise they are compiled into the library.
+ * Event dispatch itself, from the GLFW callbacks in window.cpp to the handlers, stays in the library either way:
+ * GLFW calls it through function pointers, so only the conversions it calls are affected.
+ */
+#ifdef GLFWW_INLINE_HOT_PATH
+#define GLFWW_INLINE inline
+#define GLFWW_CONSTEXPR constexpr
+#else
+#define GLFWW_INLINE
+#define GLFWW_CONSTEXPR
+#endif
+
 namespace glfwW
 {
 
@@ -20,6 +35,31 @@ struct Rect
     Vec2<T> size;
 };
 
+/*!
+ * \brief A non-owning view of a contiguous sequence
+ */
+template<typename T>
+class Span
+{
+public:
+    Span() = default;
+    Span(T* data, size_t size): m_data(data), m_size(size){}
+    Span(T* first, T* last): m_data(first), m_size(static_cast<size_t>(last - first)){}
+
+    T* begin() const {return m_data;}
+    T* end() const {return m_data + m_size;}
+    T* data() const {return m_data;}
+    size_t size() const {return m_size;}
+    bool empty() const {return m_size == 0;}
+    T& operator[](size_t index) const {return m_data[index];}
+    T& front() const {return m_data[0];}
+    T& back() const {return m_data[m_size - 1];}
+
+private:
+    T* m_data = nullptr;
+    size_t m_size = 0;
+};
+
 template<typename T = decltype (GLFW_TRUE)>
 T toGLFWBool(bool val)
 {
@@ -0,0 +1,288 @@
+#ifndef GLFWW_DELEGATE_H
+#define GLFWW_DELEGATE_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace glfwW
+{
+
+template<typename Signature>
+class Delegate;
+
+/*!
+ * \brief A non-owning, non-allocating callable: a function pointer together with a context pointer.
+ * It can be made of a free function, a captureless lambda, a callable object which outlives the delegate,
+ * or a member function bound to an object.
+ */
+template<typename R, typename... Args>
+class Delegate<R(Args...)>
+{
+public:
+    using Function = R(*)(Args...);
+    using ContextFunction = R(*)(void*, Args...);
+
+    Delegate() = default;
+
+    Delegate(Function function)
+    {
+        if(function)
+        {
+            m_function = function;
+            m_invoke = &invokeFunction;
+        }
+    }
+
+    /*!
+     * \brief Captureless lambdas are stored as plain functions.
+     */
+    template<typename F, typename = std::enable_if_t<std::is_convertible_v<F, Function> && !std::is_same_v<std::decay_t<F>, Function>>>
+    Delegate(F function):
+          Delegate(static_cast<Function>(function))
+    {}
+
+    /*!
+     * \brief References a callable object. The object has to outlive the delegate.
+     */
+    template<typename T, typename = std::enable_if_t<!std::is_convertible_v<T&, Function> &&
+                                                     !std::is_same_v<std::remove_const_t<T>, Delegate> &&
+                                                     std::is_invocable_r_v<R, T&, Args...>>>
+    Delegate(T& object):
+          m_context(const_cast<void*>(static_cast<const void*>(&object))), m_invoke(&invokeObject<T>)
+    {}
+
+    /*!
+     * \brief Calls the function with the context pointer as its first argument.
+     */
+    Delegate(ContextFunction function, void* context):
+          m_context(context), m_contextFunction(function), m_invoke(function ? &invokeContextFunction : nullptr)
+    {}
+
+    /*!
+     * \brief Binds a member function to an object.
+     */
+    template<auto Method, typename T>
+    static Delegate bind(T* object)
+    {
+        return Delegate([](void* context, Args... args) -> R {
+            return (static_cast<T*>(context)->*Method)(std::forward<Args>(args)...);
+        }, const_cast<void*>(static_cast<const void*>(object)));
+    }
+
+    explicit operator bool() const {return m_invoke != nullptr;}
+
+    R operator()(Args... args) const
+    {
+        return m_invoke(*this, std::forward<Args>(args)...);
+    }
+
+private:
+    static R invokeFunction(const Delegate& self, Args... args)
+    {
+        return self.m_function(std::forward<Args>(args)...);
+    }
+
+    static R invokeContextFunction(const Delegate& self, Args... args)
+    {
+        return self.m_contextFunction(self.m_context, std::forward<Args>(args)...);
+    }
+
+    template<typename T>
+    static R invokeObject(const Delegate& self, Args... args)
+    {
+        return (*static_cast<T*>(self.m_context))(std::forward<Args>(args)...);
+    }
+
+    void* m_context = nullptr;
+    union
+    {
+        Function m_function = nullptr;
+        ContextFunction m_contextFunction;
+    };
+    R(* m_invoke)(const Delegate&, Args...) = nullptr;
+};
+
+using SubscriptionId = int;
+
+/*!
+ * \brief Per-subscriber delivery limits
+ */
+struct SubscriptionOptions
+{
+    /*!
+     * \brief Minimal time between two deliveries to the subscriber. Events in between are suppressed.
+     */
+    std::chrono::milliseconds minInterval{0};
+    /*!
+     * \brief An event equal to the previously delivered one is suppressed if it comes within this window.
+     */
+    std::chrono::milliseconds deduplicationWindow{0};
+};
+
+/*!
+ * \brief A fixed-capacity list of event subscribers.
+ * Dispatching never allocates and costs a single atomic load when nobody is subscribed.
+ * Events may be dispatched from any thread, subscriptions have to be changed on the main thread.
+ * A slot isn't reused while a dispatch is reading it, so a handler may still run on another thread
+ * after unsubscribe() returns, but never a replaced one.
+ */
+template<typename Event, size_t Capacity = 8>
+class SubscriberList
+{
+public:
+    using Handler = Delegate<void(const Event&)>;
+
+    /*!
+     * \brief Adds a subscriber. Returns 0 if the handler is empty or no slot is free and idle.
+     */
+    SubscriptionId subscribe(Handler handler, SubscriptionOptions options = SubscriptionOptions())
+    {
+        if(!handler)
+        {
+            return 0;
+        }
+        for(auto& subscriber : m_subscribers)
+        {
+            // Pairs with the reader count and id reload in dispatch(): a slot is written only when no dispatch reads it
+            if(subscriber.id.load(std::memory_order_seq_cst) == 0 && subscriber.readers.load(std::memory_order_seq_cst) == 0)
+            {
+                subscriber.handler = handler;
+                subscriber.options = options;
+                subscriber.lastDelivery.store(0, std::memory_order_relaxed);
+                subscriber.lastKey.store(0, std::memory_order_relaxed);
+                subscriber.suppressed.store(0, std::memory_order_relaxed);
+                const SubscriptionId id = ++m_lastId;
+                subscriber.id.store(id, std::memory_order_release);
+                m_count.fetch_add(1, std::memory_order_release);
+                return id;
+            }
+        }
+        return 0;
+    }
+
+    bool unsubscribe(SubscriptionId id)
+    {
+        if(id == 0)
+        {
+            return false;
+        }
+        for(auto& subscriber : m_subscribers)
+        {
+            if(subscriber.id.load(std::memory_order_relaxed) == id)
+            {
+                subscriber.id.store(0, std::memory_order_release);
+                m_count.fetch_sub(1, std::memory_order_release);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void clear()
+    {
+        for(auto& subscriber : m_subscribers)
+        {
+            subscriber.id.store(0, std::memory_order_release);
+        }
+        m_count.store(0, std::memory_order_release);
+    }
+
+    bool empty() const
+    {
+        return m_count.load(std::memory_order_acquire) == 0;
+    }
+
+    /*!
+     * \brief Returns the number of events suppressed for the subscriber by its options.
+     */
+    uint64_t suppressedCount(SubscriptionId id) const
+    {
+        for(const auto& subscriber : m_subscribers)
+        {
+            if(id != 0 && subscriber.id.load(std::memory_order_relaxed) == id)
+            {
+                return subscriber.suppressed.load(std::memory_order_relaxed);
+            }
+        }
+        return 0;
+    }
+
+    /*!
+     * \brief Delivers the event to all subscribers which don't suppress it.
+     * \param key Identifies equal events for deduplication
+     */
+    void dispatch(const Event& event, uint64_t key = 0)
+    {
+        if(empty())
+        {
+            return;
+        }
+
+        const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                std::chrono::steady_clock::now().time_since_epoch()).count();
+        for(auto& subscriber : m_subscribers)
+        {
+            if(subscriber.id.load(std::memory_order_relaxed) == 0)
+            {
+                continue;
+            }
+            subscriber.readers.fetch_add(1, std::memory_order_seq_cst);
+            if(subscriber.id.load(std::memory_order_seq_cst) != 0)
+            {
+                if(subscriber.suppress(now, key))
+                {
+                    subscriber.suppressed.fetch_add(1, std::memory_order_relaxed);
+                }
+                else
+                {
+                    subscriber.handler(event);
+                }
+            }
+            subscriber.readers.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+private:
+    struct Subscriber
+    {
+        bool suppress(int64_t now, uint64_t key)
+        {
+            const int64_t last = lastDelivery.load(std::memory_order_relaxed);
+            const int64_t elapsed = now - last;
+            const bool delivered = last != 0;
+            if(delivered && elapsed < std::chrono::nanoseconds(options.minInterval).count())
+            {
+                return true;
+            }
+            if(delivered && key == lastKey.load(std::memory_order_relaxed) &&
+               elapsed < std::chrono::nanoseconds(options.deduplicationWindow).count())
+            {
+                return true;
+            }
+            lastDelivery.store(now, std::memory_order_relaxed);
+            lastKey.store(key, std::memory_order_relaxed);
+            return false;
+        }
+
+        std::atomic<SubscriptionId> id{0};
+        // Number of dispatches reading the slot
+        std::atomic<int> readers{0};
+        Handler handler;
+        SubscriptionOptions options;
+        std::atomic<int64_t> lastDelivery{0};
+        std::atomic<uint64_t> lastKey{0};
+        std::atomic<uint64_t> suppressed{0};
+    };
+
+    std::array<Subscriber, Capacity> m_subscribers;
+    std::atomic<size_t> m_count{0};
+    SubscriptionId m_lastId = 0;
+};
+
+}
+
+#endif
@@ -0,0 +1,397 @@
+#include "encoders.h"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace glfwW
+{
+
+namespace
+{
+
+size_t rowByteSize(const Frame& frame)
+{
+    return static_cast<size_t>(frame.size.x) * bytesPerPixel(frame.format);
+}
+
+const unsigned char* sourceRow(const Frame& frame, int row, bool flipVertically)
+{
+    const int sourceRow = flipVertically ? frame.size.y - 1 - row : row;
+    return frame.pixels.data() + static_cast<size_t>(sourceRow) * rowByteSize(frame);
+}
+
+void appendBigEndian(std::vector<unsigned char>& output, uint32_t value)
+{
+    output.push_back(static_cast<unsigned char>(value >> 24));
+    output.push_back(static_cast<unsigned char>(value >> 16));
+    output.push_back(static_cast<unsigned char>(value >> 8));
+    output.push_back(static_cast<unsigned char>(value));
+}
+
+const std::array<uint32_t, 256>& crcTable()
+{
+    static const std::array<uint32_t, 256> table = []{
+        std::array<uint32_t, 256> result{};
+        for(uint32_t i = 0; i < 256; ++i)
+        {
+            uint32_t c = i;
+            for(int k = 0; k < 8; ++k)
+            {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            result[i] = c;
+        }
+        return result;
+    }();
+    return table;
+}
+
+uint32_t crc32(const unsigned char* data, size_t size)
+{
+    const auto& table = crcTable();
+    uint32_t c = 0xFFFFFFFFu;
+    for(size_t i = 0; i < size; ++i)
+    {
+        c = table[(c ^ data[i]) & 0xFF] ^ (c >> 8);
+    }
+    return c ^ 0xFFFFFFFFu;
+}
+
+void beginChunk(std::vector<unsigned char>& output, const char* type, uint32_t length)
+{
+    appendBigEndian(output, length);
+    output.insert(output.end(), type, type + 4);
+}
+
+void endChunk(std::vector<unsigned char>& output, size_t chunkStart)
+{
+    // The CRC covers the chunk type and data, but not the length
+    const size_t begin = chunkStart + 4;
+    appendBigEndian(output, crc32(output.data() + begin, output.size() - begin));
+}
+
+/*!
+ * \brief Writes a zlib stream made of stored (uncompressed) deflate blocks.
+ */
+class StoredDeflateWriter
+{
+public:
+    StoredDeflateWriter(std::vector<unsigned char>& output, size_t totalSize):
+          m_output(output), m_remaining(totalSize)
+    {
+        m_output.push_back(0x78);
+        m_output.push_back(0x01);
+    }
+
+    void write(const unsigned char* data, size_t size)
+    {
+        while(size > 0)
+        {
+            if(m_blockRemaining == 0)
+            {
+                beginBlock();
+            }
+            const size_t count = std::min(size, m_blockRemaining);
+            m_output.insert(m_output.end(), data, data + count);
+            updateAdler(data, count);
+            data += count;
+            size -= count;
+            m_blockRemaining -= count;
+            m_remaining -= count;
+        }
+    }
+
+    void finish()
+    {
+        if(m_emptyStream)
+        {
+            beginBlock();
+        }
+        appendBigEndian(m_output, (m_adlerB << 16) | m_adlerA);
+    }
+
+private:
+    void beginBlock()
+    {
+        const size_t length = std::min<size_t>(m_remaining, 0xFFFF);
+        const bool final = length == m_remaining;
+        m_output.push_back(final ? 1 : 0);
+        m_output.push_back(static_cast<unsigned char>(length & 0xFF));
+        m_output.push_back(static_cast<unsigned char>(length >> 8));
+        m_output.push_back(static_cast<unsigned char>(~length & 0xFF));
+        m_output.push_back(static_cast<unsigned char>((~length >> 8) & 0xFF));
+        m_blockRemaining = length;
+        m_emptyStream = false;
+    }
+
+    void updateAdler(const unsigned char* data, size_t size)
+    {
+        // 5552 is the largest number of bytes the sums can take without overflowing 32 bits
+        while(size > 0)
+        {
+            const size_t count = std::min<size_t>(size, 5552);
+            for(size_t i = 0; i < count; ++i)
+            {
+                m_adlerA += data[i];
+                m_adlerB += m_adlerA;
+            }
+            m_adlerA %= 65521;
+            m_adlerB %= 65521;
+            data += count;
+            size -= count;
+        }
+    }
+
+    std::vector<unsigned char>& m_output;
+    size_t m_remaining = 0;
+    size_t m_blockRemaining = 0;
+    bool m_emptyStream = true;
+    uint32_t m_adlerA = 1;
+    uint32_t m_adlerB = 0;
+};
+
+struct QoiPixel
+{
+    unsigned char r = 0;
+    unsigned char g = 0;
+    unsigned char b = 0;
+    unsigned char a = 255;
+
+    bool operator==(const QoiPixel& rhs) const
+    {
+        return r == rhs.r && g == rhs.g && b == rhs.b && a == rhs.a;
+    }
+
+    int hash() const
+    {
+        return (r * 3 + g * 5 + b * 7 + a * 11) % 64;
+    }
+};
+
+}
+
+void encodePNG(const Frame& frame, bool flipVertically, std::vector<unsigned char>& output)
+{
+    output.clear();
+    if(frame.size.x <= 0 || frame.size.y <= 0)
+    {
+        return;
+    }
+
+    const size_t rowSize = rowByteSize(frame);
+    const size_t rawSize = (rowSize + 1) * static_cast<size_t>(frame.size.y);
+    const size_t blockCount = rawSize / 0xFFFF + 1;
+    output.reserve(8 + 25 + 12 + 2 + blockCount * 5 + rawSize + 4 + 12);
+
+    static const unsigned char signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    output.insert(output.end(), signature, signature + sizeof(signature));
+
+    size_t chunkStart = output.size();
+    beginChunk(output, "IHDR", 13);
+    appendBigEndian(output, static_cast<uint32_t>(frame.size.x));
+    appendBigEndian(output, static_cast<uint32_t>(frame.size.y));
+    output.push_back(8);
+    output.push_back(frame.format == PixelFormat::RGBA ? 6 : 2);
+    output.push_back(0);
+    output.push_back(0);
+    output.push_back(0);
+    endChunk(output, chunkStart);
+
+    chunkStart = output.size();
+    beginChunk(output, "IDAT", 0);
+    const size_t dataStart = output.size();
+    StoredDeflateWriter writer(output, rawSize);
+    const unsigned char filter = 0;
+    for(int y = 0; y < frame.size.y; ++y)
+    {
+        writer.write(&filter, 1);
+        writer.write(sourceRow(frame, y, flipVertically), rowSize);
+    }
+    writer.finish();
+    const uint32_t dataLength = static_cast<uint32_t>(output.size() - dataStart);
+    output[chunkStart] = static_cast<unsigned char>(dataLength >> 24);
+    output[chunkStart + 1] = static_cast<unsigned char>(dataLength >> 16);
+    output[chunkStart + 2] = static_cast<unsigned char>(dataLength >> 8);
+    output[chunkStart + 3] = static_cast<unsigned char>(dataLength);
+    endChunk(output, chunkStart);
+
+    chunkStart = output.size();
+    beginChunk(output, "IEND", 0);
+    endChunk(output, chunkStart);
+}
+
+void encodeQOI(const Frame& frame, bool flipVertically, std::vector<unsigned char>& output)
+{
+    output.clear();
+    if(frame.size.x <= 0 || frame.size.y <= 0)
+    {
+        return;
+    }
+
+    const int channels = bytesPerPixel(frame.format);
+    output.reserve(14 + static_cast<size_t>(frame.size.x) * frame.size.y * (channels + 1) + 8);
+
+    output.insert(output.end(), {'q', 'o', 'i', 'f'});
+    appendBigEndian(output, static_cast<uint32_t>(frame.size.x));
+    appendBigEndian(output, static_cast<uint32_t>(frame.size.y));
+    output.push_back(static_cast<unsigned char>(channels));
+    output.push_back(0);
+
+    std::array<QoiPixel, 64> index{};
+    for(auto& pixel : index)
+    {
+        pixel.a = 0;
+    }
+    QoiPixel previous;
+    int run = 0;
+
+    for(int y = 0; y < frame.size.y; ++y)
+    {
+        const unsigned char* row = sourceRow(frame, y, flipVertically);
+        for(int x = 0; x < frame.size.x; ++x)
+        {
+            const unsigned char* source = row + x * channels;
+            QoiPixel pixel;
+            pixel.r = source[0];
+            pixel.g = source[1];
+            pixel.b = source[2];
+            pixel.a = channels == 4 ? source[3] : 255;
+
+            if(pixel == previous)
+            {
+                ++run;
+                if(run == 62)
+                {
+                    output.push_back(static_cast<unsigned char>(0xC0 | (run - 1)));
+                    run = 0;
+                }
+                continue;
+            }
+            if(run > 0)
+            {
+                output.push_back(static_cast<unsigned char>(0xC0 | (run - 1)));
+                run = 0;
+            }
+
+            const int hash = pixel.hash();
+            if(index[hash] == pixel)
+            {
+                output.push_back(static_cast<unsigned char>(hash));
+            }
+            else
+            {
+                index[hash] = pixel;
+                if(pixel.a == previous.a)
+                {
+                    const int dr = static_cast<signed char>(pixel.r - previous.r);
+                    const int dg = static_cast<signed char>(pixel.g - previous.g);
+                    const int db = static_cast<signed char>(pixel.b - previous.b);
+                    const int drdg = dr - dg;
+                    const int dbdg = db - dg;
+                    if(dr > -3 && dr < 2 && dg > -3 && dg < 2 && db > -3 && db < 2)
+                    {
+                        output.push_back(static_cast<unsigned char>(0x40 | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2)));
+                    }
+                    else if(drdg > -9 && drdg < 8 && dg > -33 && dg < 32 && dbdg > -9 && dbdg < 8)
+                    {
+                        output.push_back(static_cast<unsigned char>(0x80 | (dg + 32)));
+                        output.push_back(static_cast<unsigned char>((drdg + 8) << 4 | (dbdg + 8)));
+                    }
+                    else
+                    {
+                        output.insert(output.end(), {0xFE, pixel.r, pixel.g, pixel.b});
+                    }
+                }
+                else
+                {
+                    output.insert(output.end(), {0xFF, pixel.r, pixel.g, pixel.b, pixel.a});
+                }
+            }
+            previous = pixel;
+        }
+    }
+    if(run > 0)
+    {
+        output.push_back(static_cast<unsigned char>(0xC0 | (run - 1)));
+    }
+    output.insert(output.end(), {0, 0, 0, 0, 0, 0, 0, 1});
+}
+
+std::vector<unsigned char> y4mHeader(Vec2<int> size, int framesPerSecond)
+{
+    const std::string header = "YUV4MPEG2 W" + std::to_string(size.x) + " H" + std::to_string(size.y) +
+                               " F" + std::to_string(framesPerSecond) + ":1 Ip A1:1 C420jpeg XYSCSS=420JPEG\n";
+    return std::vector<unsigned char>(header.begin(), header.end());
+}
+
+void encodeY4MFrame(const Frame& frame, bool flipVertically, std::vector<unsigned char>& output)
+{
+    output.clear();
+    if(frame.size.x <= 0 || frame.size.y <= 0)
+    {
+        return;
+    }
+
+    const int width = frame.size.x;
+    const int height = frame.size.y;
+    const int chromaWidth = (width + 1) / 2;
+    const int chromaHeight = (height + 1) / 2;
+    const int channels = bytesPerPixel(frame.format);
+    const size_t lumaSize = static_cast<size_t>(width) * height;
+    const size_t chromaSize = static_cast<size_t>(chromaWidth) * chromaHeight;
+
+    static const char frameTag[] = "FRAME\n";
+    output.resize(sizeof(frameTag) - 1 + lumaSize + chromaSize * 2);
+    std::memcpy(output.data(), frameTag, sizeof(frameTag) - 1);
+    unsigned char* lumaPlane = output.data() + sizeof(frameTag) - 1;
+    unsigned char* uPlane = lumaPlane + lumaSize;
+    unsigned char* vPlane = uPlane + chromaSize;
+
+    // BT.601 full range coefficients in 8.8 fixed point
+    for(int y = 0; y < height; ++y)
+    {
+        const unsigned char* row = sourceRow(frame, y, flipVertically);
+        unsigned char* luma = lumaPlane + static_cast<size_t>(y) * width;
+        for(int x = 0; x < width; ++x)
+        {
+            const unsigned char* p = row + x * channels;
+            luma[x] = static_cast<unsigned char>((77 * p[0] + 150 * p[1] + 29 * p[2] + 128) >> 8);
+        }
+    }
+
+    for(int cy = 0; cy < chromaHeight; ++cy)
+    {
+        const unsigned char* row0 = sourceRow(frame, cy * 2, flipVertically);
+        const unsigned char* row1 = sourceRow(frame, std::min(cy * 2 + 1, height - 1), flipVertically);
+        for(int cx = 0; cx < chromaWidth; ++cx)
+        {
+            const int x0 = cx * 2 * channels;
+            const int x1 = std::min(cx * 2 + 1, width - 1) * channels;
+            const int r = (row0[x0] + row0[x1] + row1[x0] + row1[x1] + 2) >> 2;
+            const int g = (row0[x0 + 1] + row0[x1 + 1] + row1[x0 + 1] + row1[x1 + 1] + 2) >> 2;
+            const int b = (row0[x0 + 2] + row0[x1 + 2] + row1[x0 + 2] + row1[x1 + 2] + 2) >> 2;
+            const size_t offset = static_cast<size_t>(cy) * chromaWidth + cx;
+            uPlane[offset] = static_cast<unsigned char>(std::min(255, (-43 * r - 85 * g + 128 * b + 32768 + 128) >> 8));
+            vPlane[offset] = static_cast<unsigned char>(std::min(255, (128 * r - 107 * g - 21 * b + 32768 + 128) >> 8));
+        }
+    }
+}
+
+void encodeFrame(CaptureFormat format, const Frame& frame, bool flipVertically, std::vector<unsigned char>& output)
+{
+    switch(format)
+    {
+    case CaptureFormat::PNG:
+        encodePNG(frame, flipVertically, output);
+        break;
+    case CaptureFormat::QOI:
+        encodeQOI(frame, flipVertically, output);
+        break;
+    case CaptureFormat::Y4M:
+        encodeY4MFrame(frame, flipVertically, output);
+        break;
+    }
+}
+
+}
@@ -0,0 +1,48 @@
+#ifndef GLFWW_ENCODERS_H
+#define GLFWW_ENCODERS_H
+
+#include <vector>
+#include "readback.h"
+
+namespace glfwW
+{
+
+/*!
+ * \brief Image formats frames can be encoded to
+ */
+enum class CaptureFormat
+{
+    PNG,
+    QOI,
+    Y4M
+};
+
+/*!
+ * \brief Encodes a frame as a PNG image. Image data is stored uncompressed, so encoding is limited by memory bandwidth only.
+ * \param flipVertically Frames read back from OpenGL are stored bottom-up, pass true to get a top-down image.
+ */
+void encodePNG(const Frame& frame, bool flipVertically, std::vector<unsigned char>& output);
+
+/*!
+ * \brief Encodes a frame as a QOI image.
+ */
+void encodeQOI(const Frame& frame, bool flipVertically, std::vector<unsigned char>& output);
+
+/*!
+ * \brief Returns the stream header of a raw YUV4MPEG2 video (4:2:0, full range).
+ */
+std::vector<unsigned char> y4mHeader(Vec2<int> size, int framesPerSecond);
+
+/*!
+ * \brief Converts a frame to BT.601 YUV 4:2:0 and encodes it as a single YUV4MPEG2 frame (without the stream header).
+ */
+void encodeY4MFrame(const Frame& frame, bool flipVertically, std::vector<unsigned char>& output);
+
+/*!
+ * \brief Encodes a frame in the given format. Y4M frames don't include the stream header.
+ */
+void encodeFrame(CaptureFormat format, const Frame& frame, bool flipVertically, std::vector<unsigned char>& output);
+
+}
+
+#endif
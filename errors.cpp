@@ -0,0 +1,102 @@
+#include "errors.h"
+#include <algorithm>
+#include <cstring>
+
+namespace glfwW
+{
+
+void ErrorLog::record(ErrorCode code, std::string_view description) noexcept
+{
+    m_counters[counterIndex(code)].fetch_add(1, std::memory_order_relaxed);
+
+    const uint64_t ticket = m_head.fetch_add(1, std::memory_order_relaxed);
+    Entry& entry = m_entries[ticket % CAPACITY];
+
+    entry.sequence.store(ticket * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const size_t length = std::min(description.size(), MAX_DESCRIPTION_LENGTH);
+    entry.code.store(static_cast<int>(code), std::memory_order_relaxed);
+    entry.length.store(static_cast<uint32_t>(length), std::memory_order_relaxed);
+    for(size_t i = 0; i * sizeof(uint64_t) < length; ++i)
+    {
+        uint64_t word = 0;
+        std::memcpy(&word, description.data() + i * sizeof(uint64_t), std::min(sizeof(uint64_t), length - i * sizeof(uint64_t)));
+        entry.description[i].store(word, std::memory_order_relaxed);
+    }
+
+    entry.sequence.store(ticket * 2 + 2, std::memory_order_release);
+}
+
+uint64_t ErrorLog::count(ErrorCode code) const
+{
+    return m_counters[counterIndex(code)].load(std::memory_order_relaxed);
+}
+
+uint64_t ErrorLog::totalCount() const
+{
+    uint64_t result = 0;
+    for(const auto& counter : m_counters)
+    {
+        result += counter.load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+std::vector<Error> ErrorLog::recentErrors(size_t maxCount) const
+{
+    std::vector<Error> result;
+    const uint64_t head = m_head.load(std::memory_order_acquire);
+    const uint64_t clearedHead = std::min(m_clearedHead.load(std::memory_order_relaxed), head);
+    const uint64_t count = std::min<uint64_t>({head - clearedHead, CAPACITY, maxCount});
+    result.reserve(count);
+
+    char description[MAX_DESCRIPTION_LENGTH];
+    for(uint64_t ticket = head - count; ticket < head; ++ticket)
+    {
+        const Entry& entry = m_entries[ticket % CAPACITY];
+        const uint64_t expected = ticket * 2 + 2;
+        if(entry.sequence.load(std::memory_order_acquire) != expected)
+        {
+            continue;
+        }
+
+        const auto code = static_cast<ErrorCode>(entry.code.load(std::memory_order_relaxed));
+        const size_t length = std::min<size_t>(entry.length.load(std::memory_order_relaxed), MAX_DESCRIPTION_LENGTH);
+        for(size_t i = 0; i * sizeof(uint64_t) < length; ++i)
+        {
+            const uint64_t word = entry.description[i].load(std::memory_order_relaxed);
+            std::memcpy(description + i * sizeof(uint64_t), &word, std::min(sizeof(uint64_t), length - i * sizeof(uint64_t)));
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(entry.sequence.load(std::memory_order_relaxed) != expected)
+        {
+            continue;
+        }
+
+        Error error;
+        error.code = code;
+        error.description.assign(description, length);
+        result.push_back(std::move(error));
+    }
+    return result;
+}
+
+void ErrorLog::clear()
+{
+    m_clearedHead.store(m_head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    for(auto& counter : m_counters)
+    {
+        counter.store(0, std::memory_order_relaxed);
+    }
+}
+
+size_t ErrorLog::counterIndex(ErrorCode code)
+{
+    // GLFW error codes are 0x0001000X, everything else is counted together with NO_ERROR
+    const auto value = static_cast<uint32_t>(code);
+    return (value & ~0xFu) == 0x00010000u ? value & 0xFu : 0;
+}
+
+}
@@ -0,0 +1,121 @@
+#ifndef GLFWW_ERRORS_H
+#define GLFWW_ERRORS_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace glfwW
+{
+
+enum class ErrorCode
+{
+    NO_ERROR = 0,
+    NOT_INITIALIZED = 0x00010001,
+    NO_CURRENT_CONTEXT = 0x00010002,
+    INVALID_ENUM = 0x00010003,
+    INVALID_VALUE = 0x00010004,
+    OUT_OF_MEMORY = 0x00010005,
+    API_UNAVAILABLE = 0x00010006,
+    VERSION_UNAVAILABLE = 0x00010007,
+    PLATFORM_ERROR = 0x00010008,
+    FORMAT_UNAVAILABLE = 0x00010009,
+    NO_WINDOW_CONTEXT = 0x0001000A,
+    // Reported by GLFW 3.4 and later
+    CURSOR_UNAVAILABLE = 0x0001000B,
+    FEATURE_UNAVAILABLE = 0x0001000C,
+    FEATURE_UNIMPLEMENTED = 0x0001000D,
+    PLATFORM_UNAVAILABLE = 0x0001000E,
+};
+
+struct Error
+{
+    ErrorCode code = ErrorCode::NO_ERROR;
+    std::string description;
+};
+
+/*!
+ * \brief A non-owning view of an error. The description is only valid as long as its source is.
+ */
+struct ErrorView
+{
+    ErrorCode code = ErrorCode::NO_ERROR;
+    std::string_view description;
+
+    /*!
+     * \brief Copies the error into an owning Error.
+     */
+    Error materialize() const
+    {
+        Error result;
+        result.code = code;
+        result.description.assign(description);
+        return result;
+    }
+};
+
+/*!
+ * \brief A fixed-capacity, lock-free record of recent errors together with per-code counters.
+ * Recording never allocates and may happen on any thread. Descriptions longer than MAX_DESCRIPTION_LENGTH are truncated.
+ */
+class ErrorLog
+{
+public:
+    static constexpr size_t CAPACITY = 64;
+    static constexpr size_t MAX_DESCRIPTION_LENGTH = 248;
+
+    ErrorLog() = default;
+    ErrorLog(const ErrorLog&) = delete;
+    ErrorLog& operator=(const ErrorLog&) = delete;
+
+    void record(ErrorCode code, std::string_view description) noexcept;
+
+    /*!
+     * \brief Returns the number of errors with the code recorded since the last clear().
+     */
+    uint64_t count(ErrorCode code) const;
+
+    /*!
+     * \brief Returns the number of all errors recorded since the last clear().
+     */
+    uint64_t totalCount() const;
+
+    /*!
+     * \brief Materializes up to maxCount of the most recent errors recorded since the last clear(), oldest first.
+     * Entries overwritten while being read are skipped.
+     */
+    std::vector<Error> recentErrors(size_t maxCount = CAPACITY) const;
+
+    /*!
+     * \brief Resets the counters and hides the recorded errors from recentErrors().
+     * Errors recorded concurrently with the clear may be kept.
+     */
+    void clear();
+
+private:
+    static constexpr size_t DESCRIPTION_WORDS = MAX_DESCRIPTION_LENGTH / sizeof(uint64_t);
+
+    struct Entry
+    {
+        // Odd while the entry is being written, otherwise twice the number of the write plus two
+        std::atomic<uint64_t> sequence{0};
+        std::atomic<int> code{0};
+        std::atomic<uint32_t> length{0};
+        std::array<std::atomic<uint64_t>, DESCRIPTION_WORDS> description{};
+    };
+
+    static size_t counterIndex(ErrorCode code);
+
+    std::atomic<uint64_t> m_head{0};
+    // The head at the last clear(), entries before it aren't returned
+    std::atomic<uint64_t> m_clearedHead{0};
+    std::array<Entry, CAPACITY> m_entries;
+    std::array<std::atomic<uint64_t>, 16> m_counters{};
+};
+
+}
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef GLFWW_EVENTS_H
 #define GLFWW_EVENTS_H
 
+#include <cstdint>
 #include "defs.h"
 
 namespace glfwW
@@ -13,8 +14,8 @@ enum class Action
     REPEAT
 };
 
-int toGlfwAction(Action action);
-Action fromGlfwAction(int action);
+GLFWW_CONSTEXPR int toGlfwAction(Action action);
+GLFWW_CONSTEXPR Action fromGlfwAction(int action);
 
 enum class Key
 {
@@ -147,8 +148,8 @@ enum class Key
     KEY_LAST,
 };
 
-int toGlfwKey(Key key);
-Key fromGlfwKey(int key);
+GLFWW_CONSTEXPR int toGlfwKey(Key key);
+GLFWW_CONSTEXPR Key fromGlfwKey(int key);
 
 enum KeyModifier
 {
@@ -160,30 +161,65 @@ enum KeyModifier
     NUM_LOCK
 };
 
-struct KeyEvent
+/*!
+ * \brief A set of key modifiers. The bit of each modifier matches its GLFW_MOD_* flag.
+ */
+class ModifierSet
 {
-    bool hasModifier(KeyModifier mod)
+public:
+    constexpr ModifierSet() = default;
+    constexpr ModifierSet(KeyModifier mod): m_bits(static_cast<uint8_t>(1u << mod)) {}
+
+    /*!
+     * \brief Builds the set from GLFW modifier bits. Negative values (unknown modifiers) give an empty set.
+     */
+    static constexpr ModifierSet fromGlfwBits(int bits)
     {
-        if(modifierBits < 0)
-        {
-            return false;
-        }
-        switch(mod)
-        {
-        case KeyModifier::SHIFT:
-            return modifierBits | GLFW_MOD_SHIFT;
-        case KeyModifier::CONTROL:
-            return modifierBits | GLFW_MOD_CONTROL;
-        case KeyModifier::ALT:
-            return modifierBits | GLFW_MOD_ALT;
-        case KeyModifier::SUPER:
-            return modifierBits | GLFW_MOD_SUPER;
-        case KeyModifier::CAPS_LOCK:
-            return modifierBits | GLFW_MOD_CAPS_LOCK;
-        case KeyModifier::NUM_LOCK:
-            return modifierBits | GLFW_MOD_NUM_LOCK;
-        }
+        return ModifierSet(bits < 0 ? 0 : static_cast<uint8_t>(bits & ALL_BITS));
     }
+
+    /*!
+     * \brief Returns the set without CAPS_LOCK and NUM_LOCK, which are states rather than parts of a key chord.
+     */
+    constexpr ModifierSet withoutLocks() const {return ModifierSet(m_bits & CHORD_BITS);}
+
+    constexpr bool contains(ModifierSet mods) const {return (m_bits & mods.m_bits) == mods.m_bits;}
+    constexpr bool intersects(ModifierSet mods) const {return (m_bits & mods.m_bits) != 0;}
+    constexpr bool empty() const {return m_bits == 0;}
+    constexpr int toGlfwBits() const {return m_bits;}
+
+    constexpr ModifierSet operator|(ModifierSet rhs) const {return ModifierSet(m_bits | rhs.m_bits);}
+    constexpr ModifierSet operator&(ModifierSet rhs) const {return ModifierSet(m_bits & rhs.m_bits);}
+    constexpr ModifierSet operator~() const {return ModifierSet(~m_bits & ALL_BITS);}
+    ModifierSet& operator|=(ModifierSet rhs) {m_bits |= rhs.m_bits; return *this;}
+    ModifierSet& operator&=(ModifierSet rhs) {m_bits &= rhs.m_bits; return *this;}
+    constexpr bool operator==(ModifierSet rhs) const {return m_bits == rhs.m_bits;}
+    constexpr bool operator!=(ModifierSet rhs) const {return m_bits != rhs.m_bits;}
+
+private:
+    static constexpr unsigned ALL_BITS = 0x3F;
+    static constexpr unsigned CHORD_BITS = 0x0F;
+
+    constexpr explicit ModifierSet(unsigned bits): m_bits(static_cast<uint8_t>(bits)) {}
+
+    uint8_t m_bits = 0;
+};
+
+static_assert(ModifierSet(SHIFT).toGlfwBits() == GLFW_MOD_SHIFT && ModifierSet(CONTROL).toGlfwBits() == GLFW_MOD_CONTROL &&
+              ModifierSet(ALT).toGlfwBits() == GLFW_MOD_ALT && ModifierSet(SUPER).toGlfwBits() == GLFW_MOD_SUPER &&
+              ModifierSet(CAPS_LOCK).toGlfwBits() == GLFW_MOD_CAPS_LOCK && ModifierSet(NUM_LOCK).toGlfwBits() == GLFW_MOD_NUM_LOCK,
+              "KeyModifier values must match the GLFW modifier bits");
+
+constexpr ModifierSet operator|(KeyModifier lhs, KeyModifier rhs)
+{
+    return ModifierSet(lhs) | ModifierSet(rhs);
+}
+
+struct KeyEvent
+{
+    ModifierSet modifiers() const {return ModifierSet::fromGlfwBits(modifierBits);}
+    bool hasModifier(KeyModifier mod) const {return modifiers().contains(mod);}
+
     Key key = Key::KEY_UNKNOWN;
     int scancode = -1;
     Action action = Action::PRESS;
@@ -202,11 +238,14 @@ enum class MouseButton
     BUTTON_8,
 };
 
-int toGlfwMouseButton(MouseButton button);
-MouseButton fromGlfwMouseButton(int val);
+GLFWW_CONSTEXPR int toGlfwMouseButton(MouseButton button);
+GLFWW_CONSTEXPR MouseButton fromGlfwMouseButton(int val);
 
 struct MouseButtonEvent
 {
+    ModifierSet modifiers() const {return ModifierSet::fromGlfwBits(modifierBits);}
+    bool hasModifier(KeyModifier mod) const {return modifiers().contains(mod);}
+
     MouseButton button = MouseButton::LEFT_BUTTON;
     Action action = Action::PRESS; // PRESS or RELEASE
     int modifierBits = -1;
@@ -214,4 +253,8 @@ struct MouseButtonEvent
 
 }
 
+#ifdef GLFWW_INLINE_HOT_PATH
+#include "events.inl"
+#endif
+
 #endif
@@ -0,0 +1,151 @@
+#include "gamma.h"
+#include <algorithm>
+#include <cmath>
+
+// GLFWW_NO_SIMD builds the scalar path only, e.g. to test it against the SSE2 one
+#if !defined(GLFWW_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define GLFWW_GAMMA_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace glfwW
+{
+
+namespace
+{
+
+unsigned short evaluateCurve(const GammaParameters& parameters, float exponent, float value)
+{
+    value = value > 0.0f ? std::pow(value, exponent) : 0.0f;
+    value = (value - 0.5f) * parameters.contrast + 0.5f + parameters.brightness;
+    value = std::min(std::max(value, 0.0f), 1.0f);
+    return static_cast<unsigned short>(value * 65535.0f + 0.5f);
+}
+
+#ifdef GLFWW_GAMMA_SSE2
+
+/*!
+ * \brief log2 for positive normal numbers, accurate to about one float ulp
+ */
+__m128 log2ps(__m128 x)
+{
+    const __m128i bits = _mm_castps_si128(x);
+    __m128i exponent = _mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127));
+    __m128 mantissa = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)),
+                                                    _mm_set1_epi32(0x3F800000)));
+
+    // Keep the mantissa in [sqrt(1/2), sqrt(2)) so the series below converges quickly
+    const __m128 large = _mm_cmpgt_ps(mantissa, _mm_set1_ps(1.41421356f));
+    mantissa = _mm_or_ps(_mm_andnot_ps(large, mantissa), _mm_and_ps(large, _mm_mul_ps(mantissa, _mm_set1_ps(0.5f))));
+    exponent = _mm_sub_epi32(exponent, _mm_castps_si128(large));
+
+    // log(m) = 2 * atanh(t), t = (m - 1) / (m + 1)
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 t = _mm_div_ps(_mm_sub_ps(mantissa, one), _mm_add_ps(mantissa, one));
+    const __m128 t2 = _mm_mul_ps(t, t);
+    __m128 series = _mm_set1_ps(1.0f / 9.0f);
+    series = _mm_add_ps(_mm_mul_ps(series, t2), _mm_set1_ps(1.0f / 7.0f));
+    series = _mm_add_ps(_mm_mul_ps(series, t2), _mm_set1_ps(1.0f / 5.0f));
+    series = _mm_add_ps(_mm_mul_ps(series, t2), _mm_set1_ps(1.0f / 3.0f));
+    series = _mm_add_ps(_mm_mul_ps(series, t2), one);
+    const __m128 logMantissa = _mm_mul_ps(_mm_mul_ps(series, t), _mm_set1_ps(2.0f * 1.44269504f));
+    return _mm_add_ps(_mm_cvtepi32_ps(exponent), logMantissa);
+}
+
+/*!
+ * \brief exp2 for arguments in [-126, 0]
+ */
+__m128 exp2ps(__m128 y)
+{
+    y = _mm_max_ps(y, _mm_set1_ps(-126.0f));
+    const __m128i integer = _mm_cvtps_epi32(y);
+    const __m128 f = _mm_mul_ps(_mm_sub_ps(y, _mm_cvtepi32_ps(integer)), _mm_set1_ps(0.69314718f));
+
+    // e^f for |f| <= ln(2) / 2
+    __m128 series = _mm_set1_ps(1.0f / 5040.0f);
+    series = _mm_add_ps(_mm_mul_ps(series, f), _mm_set1_ps(1.0f / 720.0f));
+    series = _mm_add_ps(_mm_mul_ps(series, f), _mm_set1_ps(1.0f / 120.0f));
+    series = _mm_add_ps(_mm_mul_ps(series, f), _mm_set1_ps(1.0f / 24.0f));
+    series = _mm_add_ps(_mm_mul_ps(series, f), _mm_set1_ps(1.0f / 6.0f));
+    series = _mm_add_ps(_mm_mul_ps(series, f), _mm_set1_ps(0.5f));
+    series = _mm_add_ps(_mm_mul_ps(series, f), _mm_set1_ps(1.0f));
+    series = _mm_add_ps(_mm_mul_ps(series, f), _mm_set1_ps(1.0f));
+
+    const __m128 scale = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(integer, _mm_set1_epi32(127)), 23));
+    return _mm_mul_ps(series, scale);
+}
+
+#endif
+
+}
+
+GammaRamp::GammaRamp(const GLFWgammaramp& ramp):
+      red(ramp.red, ramp.red + ramp.size),
+      green(ramp.green, ramp.green + ramp.size),
+      blue(ramp.blue, ramp.blue + ramp.size)
+{}
+
+GLFWgammaramp GammaRamp::toGlfwGammaRamp() const
+{
+    GLFWgammaramp result;
+    // GLFW only reads the tables, its struct just isn't const-qualified
+    result.red = const_cast<unsigned short*>(red.data());
+    result.green = const_cast<unsigned short*>(green.data());
+    result.blue = const_cast<unsigned short*>(blue.data());
+    result.size = static_cast<unsigned int>(size());
+    return result;
+}
+
+void buildGammaCurve(const GammaParameters& parameters, unsigned short* table, size_t size)
+{
+    if(!table || size == 0 || parameters.gamma <= 0.0f)
+    {
+        return;
+    }
+
+    const float exponent = 1.0f / parameters.gamma;
+    const float step = size > 1 ? 1.0f / static_cast<float>(size - 1) : 0.0f;
+    size_t i = 0;
+
+#ifdef GLFWW_GAMMA_SSE2
+    const __m128 exponents = _mm_set1_ps(exponent);
+    const __m128 contrast = _mm_set1_ps(parameters.contrast);
+    const __m128 offset = _mm_set1_ps(0.5f + parameters.brightness);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    for(; i + 4 <= size; i += 4)
+    {
+        const __m128 indices = _mm_cvtepi32_ps(_mm_add_epi32(_mm_set1_epi32(static_cast<int>(i)), _mm_set_epi32(3, 2, 1, 0)));
+        const __m128 value = _mm_mul_ps(indices, _mm_set1_ps(step));
+
+        // pow(0, e) is 0, the logarithm of 0 isn't defined
+        const __m128 positive = _mm_cmpgt_ps(value, zero);
+        __m128 curve = _mm_and_ps(positive, exp2ps(_mm_mul_ps(exponents, log2ps(_mm_max_ps(value, _mm_set1_ps(1e-30f))))));
+        curve = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(curve, half), contrast), offset);
+        curve = _mm_min_ps(_mm_max_ps(curve, zero), one);
+
+        // SSE2 has no unsigned 32 to 16 bit pack, so the values are biased into the signed range and back
+        const __m128i words = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(curve, _mm_set1_ps(65535.0f)), half));
+        const __m128i biased = _mm_sub_epi32(words, _mm_set1_epi32(32768));
+        const __m128i packed = _mm_xor_si128(_mm_packs_epi32(biased, biased), _mm_set1_epi16(static_cast<short>(0x8000)));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(table + i), packed);
+    }
+#endif
+
+    for(; i < size; ++i)
+    {
+        table[i] = evaluateCurve(parameters, exponent, static_cast<float>(i) * step);
+    }
+}
+
+GammaRamp buildGammaRamp(const GammaParameters& parameters, size_t size)
+{
+    GammaRamp result(std::min(std::max(size, GammaRamp::MIN_SIZE), GammaRamp::MAX_SIZE));
+    buildGammaCurve(parameters, result.red.data(), result.size());
+    result.green = result.red;
+    result.blue = result.red;
+    return result;
+}
+
+}
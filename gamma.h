@@ -0,0 +1,73 @@
+#ifndef GLFWW_GAMMA_H
+#define GLFWW_GAMMA_H
+
+#include <vector>
+#include "defs.h"
+
+namespace glfwW
+{
+
+/*!
+ * \brief Parameters of a generated gamma curve
+ */
+struct GammaParameters
+{
+    /*!
+     * \brief The curve is value^(1/gamma), as in glfwSetGamma
+     */
+    float gamma = 1.0f;
+    /*!
+     * \brief Offset added to the curve, -1 turns the output black and 1 white
+     */
+    float brightness = 0.0f;
+    /*!
+     * \brief Scale of the curve around its midpoint
+     */
+    float contrast = 1.0f;
+
+    bool operator==(const GammaParameters& other) const
+    {
+        return gamma == other.gamma && brightness == other.brightness && contrast == other.contrast;
+    }
+    bool operator!=(const GammaParameters& other) const {return !(*this == other);}
+};
+
+/*!
+ * \brief Gamma ramp of a monitor: one 16-bit lookup table per channel
+ */
+struct GammaRamp
+{
+    static constexpr size_t MIN_SIZE = 256;
+    static constexpr size_t MAX_SIZE = 4096;
+
+    GammaRamp() = default;
+    explicit GammaRamp(size_t size): red(size), green(size), blue(size){}
+    explicit GammaRamp(const GLFWgammaramp& ramp);
+
+    size_t size() const {return red.size();}
+    bool empty() const {return red.empty();}
+
+    /*!
+     * \brief Returns a GLFW ramp pointing into this ramp's tables
+     */
+    GLFWgammaramp toGlfwGammaRamp() const;
+
+    std::vector<unsigned short> red;
+    std::vector<unsigned short> green;
+    std::vector<unsigned short> blue;
+};
+
+/*!
+ * \brief Fills a lookup table of the given size with the curve described by the parameters.
+ * Entries are evaluated four at a time where SSE2 is available.
+ */
+void buildGammaCurve(const GammaParameters& parameters, unsigned short* table, size_t size);
+
+/*!
+ * \brief Builds a ramp with the same curve on all channels. The size is clamped to [MIN_SIZE, MAX_SIZE].
+ */
+GammaRamp buildGammaRamp(const GammaParameters& parameters, size_t size = GammaRamp::MIN_SIZE);
+
+}
+
+#endif
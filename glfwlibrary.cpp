@@ -1,4 +1,6 @@
 #include "glfwlibrary.h"
+#include <algorithm>
+#include <chrono>
 #include "utils.h"
 
 namespace glfwW
@@ -27,27 +29,248 @@ void monitorCallback(GLFWmonitor* monitor, int event)
     GLFWlibrary::instance().onMonitorEvent(monitor, event);
 }
 
+namespace
+{
+
+/*!
+ * \brief FNV-1a over the error code and description, used to recognize repeated errors
+ */
+uint64_t errorKey(const ErrorView& error)
+{
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](unsigned char byte)
+    {
+        hash ^= byte;
+        hash *= 1099511628211ull;
+    };
+    const auto code = static_cast<uint32_t>(error.code);
+    for(int shift = 0; shift < 32; shift += 8)
+    {
+        mix(static_cast<unsigned char>(code >> shift));
+    }
+    for(const char c : error.description)
+    {
+        mix(static_cast<unsigned char>(c));
+    }
+    return hash;
+}
+
+/*!
+ * \brief FNV-1a over the monitor handle and the event type, used to recognize repeated monitor events
+ */
+uint64_t monitorEventKey(GLFWmonitor* monitor, int event)
+{
+    uint64_t hash = 14695981039346656037ull;
+    const uint64_t values[] = {static_cast<uint64_t>(reinterpret_cast<uintptr_t>(monitor)), static_cast<uint32_t>(event)};
+    for(const uint64_t value : values)
+    {
+        for(int shift = 0; shift < 64; shift += 8)
+        {
+            hash ^= (value >> shift) & 0xFF;
+            hash *= 1099511628211ull;
+        }
+    }
+    return hash;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+#ifdef GLFW_PLATFORM
+
+int toGlfwPlatform(Platform platform)
+{
+    switch(platform)
+    {
+    case Platform::ANY:
+        return GLFW_ANY_PLATFORM;
+    case Platform::WINDOWS:
+        return GLFW_PLATFORM_WIN32;
+    case Platform::COCOA:
+        return GLFW_PLATFORM_COCOA;
+    case Platform::WAYLAND:
+        return GLFW_PLATFORM_WAYLAND;
+    case Platform::X11:
+        return GLFW_PLATFORM_X11;
+    case Platform::NULL_PLATFORM:
+        return GLFW_PLATFORM_NULL;
+    }
+    return GLFW_ANY_PLATFORM;
+}
+
+Platform fromGlfwPlatform(int platform)
+{
+    switch(platform)
+    {
+    case GLFW_PLATFORM_WIN32:
+        return Platform::WINDOWS;
+    case GLFW_PLATFORM_COCOA:
+        return Platform::COCOA;
+    case GLFW_PLATFORM_WAYLAND:
+        return Platform::WAYLAND;
+    case GLFW_PLATFORM_X11:
+        return Platform::X11;
+    case GLFW_PLATFORM_NULL:
+        return Platform::NULL_PLATFORM;
+    }
+    return Platform::ANY;
+}
+
+#endif
+
+}
+
 Error GLFWlibrary::init(InitHints hints)
 {
+    // glfwGetTime can't be used before glfwInit
+    const auto start = std::chrono::steady_clock::now();
+    m_startupTimings = StartupTimings();
+    m_monitorsWarm = false;
+    m_hasWindow = false;
+
     glfwInitHint(GLFW_JOYSTICK_HAT_BUTTONS, toGLFWBool(hints.joystickHatButtons));
     glfwInitHint(GLFW_COCOA_CHDIR_RESOURCES, toGLFWBool(hints.cocoaChdirResources));
     glfwInitHint(GLFW_COCOA_MENUBAR, toGLFWBool(hints.cocoaMenubar));
 
     glfwSetErrorCallback(errorCallback);
 
-    if(glfwInit() != GLFW_TRUE)
+    m_platformReport = PlatformReport();
+    m_platformReport.requested = hints.platform;
+
+    std::vector<Platform> platforms;
+    platforms.reserve(hints.fallbackPlatforms.size() + 1);
+    platforms.push_back(hints.platform);
+    platforms.insert(platforms.end(), hints.fallbackPlatforms.begin(), hints.fallbackPlatforms.end());
+
+    Error error;
+    for(const auto platform : platforms)
     {
-        return readLastError();
+        error = initPlatform(platform);
+        if(error.code == ErrorCode::NO_ERROR)
+        {
+            break;
+        }
+        PlatformAttempt attempt;
+        attempt.platform = platform;
+        attempt.error = error;
+        m_platformReport.failedAttempts.push_back(std::move(attempt));
+    }
+    if(error.code != ErrorCode::NO_ERROR)
+    {
+        return error;
     }
 
+    glfwSetMonitorCallback(monitorCallback);
+
     m_initialized = true;
+    m_platformReport.selected = getPlatform();
+    m_startupTimings.init = secondsSince(start);
+
+    if(hints.monitorWarmUp == MonitorWarmUp::IMMEDIATE)
+    {
+        warmUpMonitors();
+    }
+    else if(hints.monitorWarmUp == MonitorWarmUp::DEFERRED)
+    {
+        post([this]{
+            warmUpMonitors();
+        });
+    }
 
     return Error();
 }
 
-void GLFWlibrary::setErrorCallback(ErrorHandler* handler)
+void GLFWlibrary::warmUpMonitors()
 {
-    m_errorHandler = handler;
+    if(!m_initialized || m_monitorsWarm)
+    {
+        return;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    for(const auto& monitor : getMonitors())
+    {
+        monitor.getVideoModes();
+    }
+    m_monitorsWarm = true;
+    m_startupTimings.monitorWarmUp = secondsSince(start);
+}
+
+Platform GLFWlibrary::getPlatform() const
+{
+#ifdef GLFW_PLATFORM
+    return m_initialized ? fromGlfwPlatform(glfwGetPlatform()) : Platform::ANY;
+#else
+    return Platform::ANY;
+#endif
+}
+
+bool GLFWlibrary::platformSupported(Platform platform)
+{
+#ifdef GLFW_PLATFORM
+    return platform == Platform::ANY || glfwPlatformSupported(toGlfwPlatform(platform)) == GLFW_TRUE;
+#else
+    return platform == Platform::ANY;
+#endif
+}
+
+Error GLFWlibrary::initPlatform(Platform platform)
+{
+    if(!platformSupported(platform))
+    {
+        Error error;
+        error.code = ErrorCode::PLATFORM_UNAVAILABLE;
+#ifdef GLFW_PLATFORM
+        error.description = "GLFW was built without support for the platform";
+#else
+        error.description = "Selecting a platform requires GLFW 3.4";
+#endif
+        return error;
+    }
+
+#ifdef GLFW_PLATFORM
+    glfwInitHint(GLFW_PLATFORM, toGlfwPlatform(platform));
+#endif
+    if(glfwInit() != GLFW_TRUE)
+    {
+        return readLastError();
+    }
+    return Error();
+}
+
+void GLFWlibrary::deinit()
+{
+    m_errorHandlers.clear();
+    m_monitorHandlers.clear();
+    m_frameWaiters.cancel();
+    // Cursors have to be destroyed while the library is still initialized
+    Window::cursors.clear();
+    m_cursors.clear();
+    Monitor::clearCaches();
+    // Posted tasks, e.g. a deferred monitor warm-up, belong to this initialization
+    Task task;
+    while(m_tasks.pop(task))
+    {
+        task.reset();
+    }
+    glfwTerminate();
+    resetContextTracking();
+    invalidateCursors();
+    m_focusedWindow = nullptr;
+    m_clipboardOwned = false;
+    m_initialized = false;
+}
+
+void GLFWlibrary::setErrorCallback(ErrorHandler handler)
+{
+    m_errorHandlers.clear();
+    m_errorHandlers.subscribe(handler);
+}
+
+SubscriptionId GLFWlibrary::subscribeErrors(ErrorHandler handler, SubscriptionOptions options)
+{
+    return m_errorHandlers.subscribe(handler, options);
 }
 
 Monitor GLFWlibrary::getPrimaryMonitor() const
@@ -96,9 +319,15 @@ Monitor GLFWlibrary::getContainingMonitor(const Window& window)
     return result;
 }
 
-void GLFWlibrary::setMonitorHandler(MonitorHandler* h)
+void GLFWlibrary::setMonitorHandler(MonitorHandler h)
+{
+    m_monitorHandlers.clear();
+    m_monitorHandlers.subscribe(h);
+}
+
+SubscriptionId GLFWlibrary::subscribeMonitorEvents(MonitorHandler handler, SubscriptionOptions options)
 {
-    m_monitorHandler = h;
+    return m_monitorHandlers.subscribe(handler, options);
 }
 
 Window GLFWlibrary::createWindow(const Monitor& monitor, const std::string& title)
@@ -109,22 +338,66 @@ Window GLFWlibrary::createWindow(const Monitor& monitor, const std::string& titl
 
 Window GLFWlibrary::createWindow(const Monitor& monitor, Vec2<int> resolution, const std::string& title)
 {
-    return Window(glfwCreateWindow(resolution.x, resolution.y, title.data(), monitor.m_monitor, nullptr), Window::WindowOwnership::Owner);
+    return createGlfwWindow(resolution, title, monitor.m_monitor);
 }
 
 Window GLFWlibrary::createWindow(Vec2<int> size, const std::string& title)
 {
-    return Window(glfwCreateWindow(size.x, size.y, title.data(), nullptr, nullptr), Window::WindowOwnership::Owner);
+    return createGlfwWindow(size, title, nullptr);
 }
 
 Window GLFWlibrary::createWindow(const WindowCreationHints& hints,  Vec2<int> size, const std::string& title)
 {
+    const auto start = std::chrono::steady_clock::now();
+    const Error error = validateWindowCreationHints(hints);
+    if(error.code != ErrorCode::NO_ERROR)
+    {
+        onError(static_cast<int>(error.code), error.description.c_str());
+        return Window();
+    }
+
     hints.apply();
+    const bool first = !m_hasWindow;
     Window window = createWindow(size, title);
     apply(m_currentHints);
+    if(first && window.valid())
+    {
+        m_startupTimings.firstWindow = secondsSince(start);
+    }
     return window;
 }
 
+Error GLFWlibrary::validateWindowCreationHints(const WindowCreationHints& hints) const
+{
+    WindowCreationHints combined = m_currentHints;
+    combined.merge(hints);
+    return combined.validate();
+}
+
+Window GLFWlibrary::createOffscreenWindow(Vec2<int> size, ContextCreationAPI api)
+{
+    WindowCreationHints hints;
+    hints.addHint<WindowHint::CONTEXT_CREATION_API>(api);
+    return createOffscreenWindow(hints, size);
+}
+
+Window GLFWlibrary::createOffscreenWindow(const WindowCreationHints& hints, Vec2<int> size)
+{
+    WindowCreationHints offscreenHints = hints;
+    offscreenHints.addHint<WindowHint::VISIBLE>(false);
+    offscreenHints.addHint<WindowHint::FOCUSED>(false);
+    offscreenHints.addHint<WindowHint::FOCUS_ON_SHOW>(false);
+    if(!offscreenHints.m_contextCreationAPI)
+    {
+        offscreenHints.addHint<WindowHint::CONTEXT_CREATION_API>(ContextCreationAPI::OSMESA_CONTEXT_API);
+    }
+    if(offscreenHints.m_boolHints.find(WindowHint::DOUBLE_BUFFER) == offscreenHints.m_boolHints.end())
+    {
+        offscreenHints.addHint<WindowHint::DOUBLE_BUFFER>(false);
+    }
+    return createWindow(offscreenHints, size, "");
+}
+
 WindowCreationHints GLFWlibrary::getWindowCreationHints() const
 {
     return m_currentHints;
@@ -143,19 +416,100 @@ void GLFWlibrary::resetWindowCreationHintsToDefault()
     WindowCreationHints::resetToDefault();
 }
 
-void GLFWlibrary::pollEvents() const
+void GLFWlibrary::pollEvents()
 {
+    MetricsTimer timer(Metrics::instance().eventProcessing);
     glfwPollEvents();
+    Window::flushTextBatches();
+    runPostedTasks();
+    resumeFrameWaiters();
 }
 
-void GLFWlibrary::waitEvents() const
+void GLFWlibrary::waitEvents()
 {
     glfwWaitEvents();
+    Window::flushTextBatches();
+    runPostedTasks();
+    resumeFrameWaiters();
 }
 
-void GLFWlibrary::waitEventsTimeout(double time) const
+void GLFWlibrary::waitEventsTimeout(double time)
 {
     glfwWaitEventsTimeout(time);
+    Window::flushTextBatches();
+    runPostedTasks();
+    resumeFrameWaiters();
+}
+
+bool GLFWlibrary::post(Task task)
+{
+    if(!task || !m_tasks.push(std::move(task)))
+    {
+        return false;
+    }
+    glfwPostEmptyEvent();
+    return true;
+}
+
+std::string_view GLFWlibrary::getClipboardString()
+{
+    if(m_clipboardCaching && m_clipboardOwned && m_focusedWindow)
+    {
+        return m_clipboard;
+    }
+
+    const char* text = glfwGetClipboardString(nullptr);
+    if(!text)
+    {
+        m_clipboard.clear();
+        return m_clipboard;
+    }
+
+    // Reassigning keeps the buffer's capacity, so a clipboard of the same size doesn't allocate
+    const std::string_view fetched(text);
+    if(fetched != m_clipboard)
+    {
+        m_clipboard.assign(fetched);
+    }
+    m_clipboardOwned = true;
+    return m_clipboard;
+}
+
+size_t GLFWlibrary::readClipboard(size_t offset, char* buffer, size_t size)
+{
+    const auto text = getClipboardString();
+    if(!buffer || offset >= text.size())
+    {
+        return 0;
+    }
+    return text.copy(buffer, size, offset);
+}
+
+void GLFWlibrary::readClipboardChunks(size_t chunkSize, const std::function<void(std::string_view)>& handler)
+{
+    const auto text = getClipboardString();
+    if(chunkSize == 0 || !handler)
+    {
+        return;
+    }
+    for(size_t offset = 0; offset < text.size(); offset += chunkSize)
+    {
+        handler(text.substr(offset, chunkSize));
+    }
+}
+
+void GLFWlibrary::setClipboardString(std::string_view text)
+{
+    m_clipboard.assign(text);
+    glfwSetClipboardString(nullptr, m_clipboard.c_str());
+    m_clipboardOwned = true;
+}
+
+bool GLFWlibrary::postClipboardString(std::string text)
+{
+    return post([this, text = std::move(text)]{
+        setClipboardString(text);
+    });
 }
 
 int GLFWlibrary::getKeyScancode(Key key) const
@@ -178,25 +532,160 @@ bool GLFWlibrary::isRawMouseMotionSupported() const
     return glfwRawMouseMotionSupported();
 }
 
-void GLFWlibrary::onError(int errorCode, const char *description) const
+Cursor GLFWlibrary::createCursor(StandardCursorShape shape)
 {
-    if(m_errorHandler)
+    CursorKey key;
+    key.standardShape = toGlfwCursorShape(shape);
+
+    auto itr = m_cursors.find(key);
+    if(itr == m_cursors.end())
     {
-        Error error;
-        error.code = static_cast<ErrorCode>(errorCode);
-        error.description.assign(description);
-        std::invoke(*m_errorHandler, error);
+        Cursor cursor(glfwCreateStandardCursor(key.standardShape));
+        if(!cursor.valid())
+        {
+            return cursor;
+        }
+        itr = m_cursors.emplace(key, CachedCursor{{}, cursor});
+    }
+    return itr->second.cursor;
+}
+
+Cursor GLFWlibrary::createCursor(const GLFWimage& image, Vec2<int> hotspot)
+{
+    CursorKey key;
+    key.imageHash = hashImage(image);
+    key.size = {image.width, image.height};
+    key.hotspot = hotspot;
+    const unsigned char* pixels = image.pixels;
+    const size_t pixelsSize = pixels && image.width > 0 && image.height > 0 ?
+                                  static_cast<size_t>(image.width) * image.height * 4 : 0;
+
+    // The pixels are compared only for matching keys and copied only for new cursors
+    const auto range = m_cursors.equal_range(key);
+    for(auto itr = range.first; itr != range.second; ++itr)
+    {
+        const auto& cached = itr->second.pixels;
+        if(cached.size() == pixelsSize && std::equal(cached.begin(), cached.end(), pixels))
+        {
+            return itr->second.cursor;
+        }
+    }
+
+    Cursor cursor(glfwCreateCursor(&image, hotspot.x, hotspot.y));
+    if(cursor.valid())
+    {
+        m_cursors.emplace(key, CachedCursor{std::vector<unsigned char>(pixels, pixels + pixelsSize), cursor});
+    }
+    return cursor;
+}
+
+void GLFWlibrary::releaseUnusedCursors()
+{
+    for(auto itr = m_cursors.begin(); itr != m_cursors.end();)
+    {
+        if(itr->second.cursor.m_cursor.use_count() == 1)
+        {
+            itr = m_cursors.erase(itr);
+        }
+        else
+        {
+            ++itr;
+        }
+    }
+}
+
+void GLFWlibrary::onError(int errorCode, const char *description)
+{
+    ErrorView error;
+    error.code = static_cast<ErrorCode>(errorCode);
+    if(description)
+    {
+        error.description = description;
+    }
+    m_errorLog.record(error.code, error.description);
+    if(!m_errorHandlers.empty())
+    {
+        m_errorHandlers.dispatch(error, errorKey(error));
+    }
+}
+
+void GLFWlibrary::onWindowFocus(GLFWwindow* window, bool focused)
+{
+    // Applications usually change the clipboard while they have focus, so the cache is dropped on every focus change
+    if(focused)
+    {
+        m_focusedWindow = window;
+    }
+    else if(m_focusedWindow == window)
+    {
+        m_focusedWindow = nullptr;
+    }
+    m_clipboardOwned = false;
+}
+
+void GLFWlibrary::onWindowDestroyed(GLFWwindow* window)
+{
+    // GLFW doesn't report the focus loss of a destroyed window
+    onWindowFocus(window, false);
+}
+
+Window GLFWlibrary::createGlfwWindow(Vec2<int> size, const std::string& title, GLFWmonitor* monitor)
+{
+    const auto start = std::chrono::steady_clock::now();
+    Window window = makeWindow(glfwCreateWindow(size.x, size.y, title.data(), monitor, nullptr));
+    if(!m_hasWindow && window.valid())
+    {
+        m_hasWindow = true;
+        m_startupTimings.firstWindow = secondsSince(start);
+    }
+    return window;
+}
+
+Window GLFWlibrary::makeWindow(GLFWwindow* window)
+{
+    if(window)
+    {
+        glfwSetWindowFocusCallback(window, windowFocusCallback);
+        // Windows are usually focused on creation, before the callback is set
+        if(glfwGetWindowAttrib(window, GLFW_FOCUSED) == GLFW_TRUE)
+        {
+            onWindowFocus(window, true);
+        }
+    }
+    return Window(window, Window::WindowOwnership::Owner);
+}
+
+void GLFWlibrary::resumeFrameWaiters()
+{
+    if(!m_frameWaiters.empty())
+    {
+        FrameEvent event;
+        event.index = ++m_frameIndex;
+        event.time = glfwGetTime();
+        m_frameWaiters.notify(event);
+    }
+}
+
+void GLFWlibrary::runPostedTasks()
+{
+    // Only the tasks queued on entry run, so tasks which keep posting themselves can't starve event processing
+    Task task;
+    for(size_t pending = m_tasks.size(); pending > 0 && m_tasks.pop(task); --pending)
+    {
+        task();
+        task.reset();
     }
 }
 
-void GLFWlibrary::onMonitorEvent(GLFWmonitor *monitor, int event) const
+void GLFWlibrary::onMonitorEvent(GLFWmonitor *monitor, int event)
 {
-    if(m_monitorHandler)
+    Monitor::onMonitorEvent(monitor, event == GLFW_CONNECTED);
+    if(!m_monitorHandlers.empty())
     {
         MonitorEvent monitorEvent;
         monitorEvent.monitor = Monitor(monitor);
         monitorEvent.type = fromGlfwMonitorEventType(event);
-        std::invoke(*m_monitorHandler, monitorEvent);
+        m_monitorHandlers.dispatch(monitorEvent, monitorEventKey(monitor, event));
     }
 }
 
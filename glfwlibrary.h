@@ -4,40 +4,99 @@
 #include <cstring>
 #include <functional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "delegate.h"
+#include "errors.h"
 #include "monitor.h"
+#include "mouse.h"
+#include "task.h"
 #include "window.h"
 
 namespace glfwW
 {
 
-enum class ErrorCode
+enum class MonitorEventType
 {
-    NO_ERROR = 0,
-    NOT_INITIALIZED = 0x00010001,
-    NO_CURRENT_CONTEXT = 0x00010002,
-    INVALID_ENUM = 0x00010003,
-    INVALID_VALUE = 0x00010004,
-    OUT_OF_MEMORY = 0x00010005,
-    API_UNAVAILABLE = 0x00010006,
-    VERSION_UNAVAILABLE = 0x00010007,
-    PLATFORM_ERROR = 0x00010008,
-    FORMAT_UNAVAILABLE = 0x00010009,
-    NO_WINDOW_CONTEXT = 0x0001000A,
+    CONNECTED,
+    DISCONNECTED
 };
 
-struct Error
+MonitorEventType fromGlfwMonitorEventType(int type);
+
+/*!
+ * \brief A window system backend of GLFW. Selecting one requires GLFW 3.4.
+ * NULL_PLATFORM creates no real windows and needs no display, e.g. for CI and server tools.
+ */
+enum class Platform
 {
-    ErrorCode code = ErrorCode::NO_ERROR;
-    std::string description;
+    ANY,
+    WINDOWS,
+    COCOA,
+    WAYLAND,
+    X11,
+    NULL_PLATFORM
 };
 
-enum class MonitorEventType
+/*!
+ * \brief A platform init failed to initialize GLFW with
+ */
+struct PlatformAttempt
 {
-    CONNECTED,
-    DISCONNECTED
+    Platform platform = Platform::ANY;
+    Error error;
 };
 
-MonitorEventType fromGlfwMonitorEventType(int type);
+/*!
+ * \brief Describes how GLFWlibrary::init selected the platform
+ */
+struct PlatformReport
+{
+    Platform requested = Platform::ANY;
+    /*!
+     * \brief The platform GLFW runs on. ANY if it can't be queried (before GLFW 3.4) or init failed.
+     */
+    Platform selected = Platform::ANY;
+    /*!
+     * \brief Platforms tried before the selected one, with the reasons they failed
+     */
+    std::vector<PlatformAttempt> failedAttempts;
+
+    bool fellBack() const {return !failedAttempts.empty();}
+};
+
+/*!
+ * \brief When GLFWlibrary fills the monitor and video mode caches
+ */
+enum class MonitorWarmUp
+{
+    // On first use
+    LAZY,
+    // During init
+    IMMEDIATE,
+    // During the first event processing, so init returns and the first window is created before it
+    DEFERRED
+};
+
+/*!
+ * \brief Durations of the startup phases of GLFWlibrary in seconds. A phase that hasn't happened yet takes 0.
+ */
+struct StartupTimings
+{
+    /*!
+     * \brief Platform selection and glfwInit
+     */
+    double init = 0.0;
+    /*!
+     * \brief Filling the monitor and video mode caches
+     */
+    double monitorWarmUp = 0.0;
+    /*!
+     * \brief Creation of the first window, including the validation of its hints
+     */
+    double firstWindow = 0.0;
+};
 
 struct MonitorEvent
 {
@@ -45,6 +104,15 @@ struct MonitorEvent
     MonitorEventType type = MonitorEventType::CONNECTED;
 };
 
+/*!
+ * \brief An iteration of the event loop, passed to coroutines awaiting GLFWlibrary::frame()
+ */
+struct FrameEvent
+{
+    uint64_t index = 0;
+    double time = 0.0;
+};
+
 void errorCallback(int errorCode, const char *description);
 void monitorCallback(GLFWmonitor* monitor, int event);
 
@@ -54,8 +122,8 @@ void monitorCallback(GLFWmonitor* monitor, int event);
 class GLFWlibrary
 {
 public:
-    typedef void(* ErrorHandler) (const Error&);
-    typedef void(* MonitorHandler) (const MonitorEvent&);
+    using ErrorHandler = Delegate<void(const ErrorView&)>;
+    using MonitorHandler = Delegate<void(const MonitorEvent&)>;
 
     struct InitHints
     {
@@ -69,6 +137,15 @@ public:
         bool joystickHatButtons = true;
         bool cocoaChdirResources = true;
         bool cocoaMenubar = true;
+        /*!
+         * \brief The platform to initialize. ANY lets GLFW choose.
+         */
+        Platform platform = Platform::ANY;
+        /*!
+         * \brief Platforms tried in order if the requested one fails, e.g. {Platform::X11, Platform::NULL_PLATFORM}
+         */
+        std::vector<Platform> fallbackPlatforms;
+        MonitorWarmUp monitorWarmUp = MonitorWarmUp::LAZY;
     };
 
     struct Version
@@ -98,24 +175,88 @@ public:
      */
     bool initialized() const {return m_initialized;}
 
-    void deinit()
-    {
-        m_errorHandler = nullptr;
-        glfwTerminate();
-    }
+    /*!
+     * \brief Returns how the last init call selected the platform.
+     */
+    const PlatformReport& platformReport() const {return m_platformReport;}
+
+    /*!
+     * \brief Returns the durations of the startup phases since the last init call.
+     */
+    const StartupTimings& startupTimings() const {return m_startupTimings;}
+
+    /*!
+     * \brief Queries the monitors and fills the video mode caches, so later monitor queries and fullscreen window
+     * creation don't wait for the window system. Does nothing if the caches have been warmed up since init.
+     */
+    void warmUpMonitors();
+
+    /*!
+     * \brief Returns the platform GLFW runs on, or ANY if it isn't initialized or can't be queried (before GLFW 3.4).
+     */
+    Platform getPlatform() const;
+
+    /*!
+     * \brief Returns true if GLFW was built with support for the platform. Can be called before init.
+     * Always false for a specific platform before GLFW 3.4.
+     */
+    static bool platformSupported(Platform platform);
+
+    void deinit();
 
     //ERRORS
-    void setErrorCallback(ErrorHandler* handler);
+    /*!
+     * \brief Replaces all error subscribers with the handler. An empty handler removes them.
+     */
+    void setErrorCallback(ErrorHandler handler);
+
+    /*!
+     * \brief Adds an error handler. Handlers may be called on any thread which causes an error.
+     * Returns 0 if all subscriber slots are taken.
+     */
+    SubscriptionId subscribeErrors(ErrorHandler handler, SubscriptionOptions options = SubscriptionOptions());
+
+    bool unsubscribeErrors(SubscriptionId id) {return m_errorHandlers.unsubscribe(id);}
 
+    /*!
+     * \brief Returns the number of errors which the subscriber's rate limit or deduplication kept from it.
+     */
+    uint64_t suppressedErrors(SubscriptionId id) const {return m_errorHandlers.suppressedCount(id);}
+
+    /*!
+     * \brief Returns and clears the last error of the calling thread.
+     */
     Error readLastError() const
     {
-        Error result;
-        const char* err;
+        return readLastErrorView().materialize();
+    }
+
+    /*!
+     * \brief Returns and clears the last error of the calling thread without copying its description.
+     * The description is valid until the next error or until the library is terminated.
+     */
+    ErrorView readLastErrorView() const
+    {
+        ErrorView result;
+        const char* err = nullptr;
         result.code = static_cast<ErrorCode>(glfwGetError(&err));
-        result.description.assign(err);
+        if(err)
+        {
+            result.description = err;
+        }
         return result;
     }
 
+    /*!
+     * \brief Returns the log of recent errors and per-code error counters.
+     */
+    const ErrorLog& errorLog() const {return m_errorLog;}
+
+    /*!
+     * \brief Resets the error counters and the recent errors.
+     */
+    void clearErrorLog() {m_errorLog.clear();}
+
     //INFORMATION
     Version version() const
     {
@@ -144,9 +285,16 @@ public:
     Monitor getContainingMonitor(const Window& window);
 
     /*!
-     * \brief Sets monitor handler callback. Callback is invoked if monitor was connected or disconnected.
+     * \brief Replaces all monitor subscribers with the handler. Handler is invoked if monitor was connected or disconnected.
      */
-    void setMonitorHandler(MonitorHandler* h);
+    void setMonitorHandler(MonitorHandler h);
+
+    /*!
+     * \brief Adds a monitor handler. Returns 0 if all subscriber slots are taken.
+     */
+    SubscriptionId subscribeMonitorEvents(MonitorHandler handler, SubscriptionOptions options = SubscriptionOptions());
+
+    bool unsubscribeMonitorEvents(SubscriptionId id) {return m_monitorHandlers.unsubscribe(id);}
 
     //WINDOWS
     /*!
@@ -165,10 +313,30 @@ public:
     Window createWindow(Vec2<int> size, const std::string& title);
 
     /*!
-     * \brief Creates a new window with particular creation hints
+     * \brief Creates a new window with particular creation hints.
+     * The hints, combined with the current ones, are validated first. If they are invalid, the error is reported
+     * to the error handlers and an invalid window is returned.
      */
     Window createWindow(const WindowCreationHints& hints,  Vec2<int> size, const std::string& title);
 
+    /*!
+     * \brief Validates the hints combined with the current ones, e.g. to check the configurations an application
+     * can use at startup instead of on the first failing createWindow call.
+     */
+    Error validateWindowCreationHints(const WindowCreationHints& hints) const;
+
+    /*!
+     * \brief Creates an invisible, single buffered window whose context is used for offscreen rendering.
+     * By default the context is created through OSMesa, so neither a GPU nor a visible surface is required.
+     */
+    Window createOffscreenWindow(Vec2<int> size, ContextCreationAPI api = ContextCreationAPI::OSMESA_CONTEXT_API);
+
+    /*!
+     * \brief Creates an offscreen window with particular creation hints.
+     * Visibility and focus hints are always overridden. Context creation API and buffering are only set if the hints don't specify them.
+     */
+    Window createOffscreenWindow(const WindowCreationHints& hints, Vec2<int> size);
+
     /*!
      * \brief Returns a set of window creation hints which were changed by this wrapper.
      */
@@ -188,18 +356,80 @@ public:
     /*!
      * \brief Processes events from the event queue immediately. Processing events will cause the window and input callbacks associated with those events to be called.
      */
-    void pollEvents() const;
+    void pollEvents();
 
     /*!
      * \brief Puts the calling thread to sleep until at least one event is available in the event queue.
      * Once one or more events are available, the events in the queue are processed and the function then returns immediately.
      */
-    void waitEvents() const;
+    void waitEvents();
 
     /*!
      * \brief Puts the calling thread to sleep until at least one event is available in the event queue, or until the specified timeout is reached.
      */
-    void waitEventsTimeout(double time) const;
+    void waitEventsTimeout(double time);
+
+    /*!
+     * \brief Runs the task on the main thread during the next event processing and wakes the event loop up for it.
+     * May be called from any thread without locking. Callables of up to Task::INLINE_SIZE bytes are posted without allocation.
+     * Returns false if the task queue is full.
+     */
+    bool post(Task task);
+
+    /*!
+     * \brief Returns an awaitable for the end of the next event processing: co_await lib.frame().
+     */
+    EventAwaiter<FrameEvent> frame() {return EventAwaiter<FrameEvent>(&m_frameWaiters);}
+
+    /*!
+     * \brief Returns true if a coroutine awaits the next frame, so the event loop shouldn't block.
+     */
+    bool hasFrameWaiters() const {return !m_frameWaiters.empty();}
+
+    // CLIPBOARD
+    /*!
+     * \brief Returns the contents of the system clipboard as UTF-8.
+     * The view points into a reused buffer and stays valid until the next clipboard call.
+     * The contents are fetched on every call unless caching is enabled with setClipboardCaching().
+     */
+    std::string_view getClipboardString();
+
+    /*!
+     * \brief Copies up to size bytes of the clipboard contents starting at offset into the buffer.
+     * Returns the number of bytes copied.
+     */
+    size_t readClipboard(size_t offset, char* buffer, size_t size);
+
+    /*!
+     * \brief Passes the clipboard contents to the handler in consecutive chunks of at most chunkSize bytes.
+     */
+    void readClipboardChunks(size_t chunkSize, const std::function<void(std::string_view)>& handler);
+
+    /*!
+     * \brief Sets the contents of the system clipboard. Has to be called on the main thread.
+     */
+    void setClipboardString(std::string_view text);
+
+    /*!
+     * \brief Sets the contents of the system clipboard from any thread.
+     * The text is applied on the main thread during the next event processing, which is woken up for it.
+     * Returns false if the task queue is full.
+     */
+    bool postClipboardString(std::string text);
+
+    /*!
+     * \brief Enables caching of the clipboard contents, disabled by default.
+     * The cached contents are returned while one of the library's windows has kept focus since they were fetched or set.
+     * This is a heuristic: clipboard managers and command line tools may change the clipboard while a window is focused,
+     * and GLFW can't report it. Enable it only if the application calls invalidateClipboardCache() in such cases.
+     */
+    void setClipboardCaching(bool enabled) {m_clipboardCaching = enabled;}
+    bool clipboardCaching() const {return m_clipboardCaching;}
+
+    /*!
+     * \brief Makes the next getClipboardString() fetch the clipboard contents.
+     */
+    void invalidateClipboardCache() {m_clipboardOwned = false;}
 
     // KEYBOARD
     /*!
@@ -212,9 +442,26 @@ public:
 
     // MOUSE
     bool isRawMouseMotionSupported() const;
+
+    /*!
+     * \brief Returns a cursor with a standard shape. Cursors are cached, so repeated calls return the same native cursor.
+     */
+    Cursor createCursor(StandardCursorShape shape);
+
+    /*!
+     * \brief Returns a cursor made of an RGBA image. The cache is keyed by the image contents and the hotspot.
+     */
+    Cursor createCursor(const GLFWimage& image, Vec2<int> hotspot);
+
+    /*!
+     * \brief Destroys cached cursors which aren't referenced by any handle.
+     */
+    void releaseUnusedCursors();
 private:
     friend void errorCallback(int errorCode, const char *description);
     friend void monitorCallback(GLFWmonitor* monitor, int event);
+    friend void windowFocusCallback(GLFWwindow* window, int focused);
+    friend class Window;
 
     GLFWlibrary() = default;
 
@@ -223,14 +470,44 @@ private:
         deinit();
     }
 
-    void onError(int errorCode, const char *description) const;
-    void onMonitorEvent(GLFWmonitor* monitor, int event) const;
+    void onError(int errorCode, const char *description);
+    void onMonitorEvent(GLFWmonitor* monitor, int event);
+    void onWindowFocus(GLFWwindow* window, bool focused);
+    void onWindowDestroyed(GLFWwindow* window);
+
+    /*!
+     * \brief Initializes GLFW on the platform.
+     */
+    Error initPlatform(Platform platform);
+
+    Window makeWindow(GLFWwindow* window);
+    Window createGlfwWindow(Vec2<int> size, const std::string& title, GLFWmonitor* monitor);
+    /*!
+     * \brief Runs the posted tasks. Tasks posted by them run during the next event processing.
+     */
+    void runPostedTasks();
+    void resumeFrameWaiters();
 
 private:
     bool m_initialized = false;
-    ErrorHandler* m_errorHandler = nullptr;
-    MonitorHandler* m_monitorHandler = nullptr;
+    PlatformReport m_platformReport;
+    StartupTimings m_startupTimings;
+    bool m_monitorsWarm = false;
+    bool m_hasWindow = false;
+    SubscriberList<ErrorView> m_errorHandlers;
+    ErrorLog m_errorLog;
+    SubscriberList<MonitorEvent> m_monitorHandlers;
     WindowCreationHints m_currentHints;
+    std::unordered_multimap<CursorKey, CachedCursor, CursorKeyHash> m_cursors;
+
+    std::string m_clipboard;
+    bool m_clipboardOwned = false;
+    bool m_clipboardCaching = false;
+    GLFWwindow* m_focusedWindow = nullptr;
+
+    TaskQueue m_tasks;
+    WaiterList<FrameEvent> m_frameWaiters;
+    uint64_t m_frameIndex = 0;
 };
 
 }
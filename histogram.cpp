@@ -0,0 +1,165 @@
+#include "histogram.h"
+#include <algorithm>
+
+namespace glfwW
+{
+
+namespace
+{
+
+constexpr size_t HALF_SUB_BUCKET_COUNT = HistogramLayout::SUB_BUCKET_COUNT / 2;
+
+unsigned highestBit(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#else
+    unsigned result = 0;
+    for(unsigned shift = 32; shift; shift >>= 1)
+    {
+        if(value >> shift)
+        {
+            value >>= shift;
+            result += shift;
+        }
+    }
+    return result;
+#endif
+}
+
+}
+
+size_t HistogramLayout::bucketIndex(uint64_t value)
+{
+    if(value < SUB_BUCKET_COUNT)
+    {
+        return static_cast<size_t>(value);
+    }
+    const unsigned exponent = highestBit(value);
+    if(exponent >= MAX_VALUE_BITS)
+    {
+        return BUCKET_COUNT - 1;
+    }
+    // The top SUB_BUCKET_BITS - 1 bits below the highest one select the linear bucket
+    const unsigned shift = exponent - (SUB_BUCKET_BITS - 1);
+    const auto subBucket = static_cast<size_t>(value >> shift) - HALF_SUB_BUCKET_COUNT;
+    return SUB_BUCKET_COUNT + (exponent - SUB_BUCKET_BITS) * HALF_SUB_BUCKET_COUNT + subBucket;
+}
+
+uint64_t HistogramLayout::bucketUpperBound(size_t index)
+{
+    if(index < SUB_BUCKET_COUNT)
+    {
+        return index;
+    }
+    if(index >= BUCKET_COUNT - 1)
+    {
+        return UINT64_MAX;
+    }
+    const size_t offset = index - SUB_BUCKET_COUNT;
+    const unsigned exponent = SUB_BUCKET_BITS + static_cast<unsigned>(offset / HALF_SUB_BUCKET_COUNT);
+    const uint64_t subBucket = HALF_SUB_BUCKET_COUNT + offset % HALF_SUB_BUCKET_COUNT;
+    const unsigned shift = exponent - (SUB_BUCKET_BITS - 1);
+    return ((subBucket + 1) << shift) - 1;
+}
+
+HistogramSnapshot::HistogramSnapshot():
+    m_buckets(HistogramLayout::BUCKET_COUNT, 0)
+{
+}
+
+uint64_t HistogramSnapshot::percentile(double percent) const
+{
+    if(!m_count)
+    {
+        return 0;
+    }
+    const double fraction = std::min(std::max(percent, 0.0), 100.0) / 100.0;
+    const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(fraction * m_count + 0.5));
+    uint64_t seen = 0;
+    for(size_t i = 0; i < m_buckets.size(); ++i)
+    {
+        seen += m_buckets[i];
+        if(seen >= rank)
+        {
+            return std::min(std::max(HistogramLayout::bucketUpperBound(i), min()), m_max);
+        }
+    }
+    return m_max;
+}
+
+void HistogramSnapshot::merge(const HistogramSnapshot& other)
+{
+    for(size_t i = 0; i < m_buckets.size(); ++i)
+    {
+        m_buckets[i] += other.m_buckets[i];
+    }
+    m_count += other.m_count;
+    m_sum += other.m_sum;
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+}
+
+void HistogramSnapshot::reset()
+{
+    std::fill(m_buckets.begin(), m_buckets.end(), 0);
+    m_count = 0;
+    m_sum = 0;
+    m_min = UINT64_MAX;
+    m_max = 0;
+}
+
+uint64_t Histogram::count() const
+{
+    uint64_t result = 0;
+    for(const auto& bucket : m_buckets)
+    {
+        result += bucket.load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+HistogramSnapshot Histogram::snapshot() const
+{
+    HistogramSnapshot result;
+    snapshot(result);
+    return result;
+}
+
+void Histogram::snapshot(HistogramSnapshot& result) const
+{
+    result.m_buckets.resize(HistogramLayout::BUCKET_COUNT);
+    uint64_t count = 0;
+    for(size_t i = 0; i < HistogramLayout::BUCKET_COUNT; ++i)
+    {
+        result.m_buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+        count += result.m_buckets[i];
+    }
+    // Counting the buckets keeps percentiles consistent while values are recorded, and saves recording a count
+    result.m_count = count;
+    result.m_sum = 0;
+    result.m_min = UINT64_MAX;
+    result.m_max = 0;
+    for(const auto& stripe : m_stripes)
+    {
+        result.m_sum += stripe.sum.load(std::memory_order_relaxed);
+        result.m_min = std::min(result.m_min, stripe.min.load(std::memory_order_relaxed));
+        result.m_max = std::max(result.m_max, stripe.max.load(std::memory_order_relaxed));
+    }
+}
+
+void Histogram::reset()
+{
+    for(auto& bucket : m_buckets)
+    {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    for(auto& stripe : m_stripes)
+    {
+        stripe.sum.store(0, std::memory_order_relaxed);
+        stripe.min.store(UINT64_MAX, std::memory_order_relaxed);
+        stripe.max.store(0, std::memory_order_relaxed);
+    }
+}
+
+}
@@ -0,0 +1,152 @@
+#ifndef GLFWW_HISTOGRAM_H
+#define GLFWW_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace glfwW
+{
+
+/*!
+ * \brief Bucket layout shared by Histogram and HistogramSnapshot.
+ * Values below 2^SUB_BUCKET_BITS have a bucket each. Above that every power of two range is split into
+ * 2^(SUB_BUCKET_BITS - 1) linear buckets, so a bucket is never wider than 1/32 of its values (about 3%).
+ * Values from 2^MAX_VALUE_BITS up share the last bucket.
+ */
+struct HistogramLayout
+{
+    static constexpr unsigned SUB_BUCKET_BITS = 6;
+    static constexpr unsigned MAX_VALUE_BITS = 40;
+    static constexpr size_t SUB_BUCKET_COUNT = size_t(1) << SUB_BUCKET_BITS;
+    static constexpr size_t BUCKET_COUNT = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 2) * (SUB_BUCKET_COUNT / 2);
+
+    static size_t bucketIndex(uint64_t value);
+
+    /*!
+     * \brief Returns the largest value falling into the bucket
+     */
+    static uint64_t bucketUpperBound(size_t index);
+};
+
+/*!
+ * \brief A plain copy of a Histogram for queries and aggregation
+ */
+class HistogramSnapshot
+{
+public:
+    HistogramSnapshot();
+
+    uint64_t count() const {return m_count;}
+    uint64_t min() const {return m_count ? m_min : 0;}
+    uint64_t max() const {return m_max;}
+    double mean() const {return m_count ? static_cast<double>(m_sum) / m_count : 0.0;}
+
+    /*!
+     * \brief Returns a value not less than the given percentile (0 - 100) of the recorded values,
+     * e.g. percentile(99.9). The result is within the bucket precision and never exceeds max().
+     */
+    uint64_t percentile(double percent) const;
+
+    uint64_t bucket(size_t index) const {return m_buckets[index];}
+
+    /*!
+     * \brief Adds the values of another snapshot, e.g. to combine histograms of several windows or threads.
+     */
+    void merge(const HistogramSnapshot& other);
+
+    void reset();
+
+private:
+    friend class Histogram;
+
+    std::vector<uint64_t> m_buckets;
+    uint64_t m_count = 0;
+    uint64_t m_sum = 0;
+    uint64_t m_min = UINT64_MAX;
+    uint64_t m_max = 0;
+};
+
+/*!
+ * \brief A log-linear (HDR style) histogram of unsigned values, e.g. durations in nanoseconds.
+ * Recording is lock-free, doesn't allocate, and can be done from several threads at once.
+ * Sum, min and max are kept in per-thread stripes on separate cache lines and combined by snapshot(),
+ * so threads only share the bucket counters.
+ * A snapshot taken while values are recorded may miss the most recent ones.
+ */
+class Histogram
+{
+public:
+    Histogram() = default;
+    Histogram(const Histogram&) = delete;
+    Histogram& operator=(const Histogram&) = delete;
+
+    void record(uint64_t value)
+    {
+        m_buckets[HistogramLayout::bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+        auto& stripe = m_stripes[stripeIndex()];
+        stripe.sum.fetch_add(value, std::memory_order_relaxed);
+        stripe.updateMin(value);
+        stripe.updateMax(value);
+    }
+
+    /*!
+     * \brief Returns the number of recorded values. It sums the buckets, so it isn't meant for hot paths.
+     */
+    uint64_t count() const;
+
+    HistogramSnapshot snapshot() const;
+
+    /*!
+     * \brief Copies the histogram into an existing snapshot, reusing its memory.
+     */
+    void snapshot(HistogramSnapshot& result) const;
+
+    /*!
+     * \brief Clears the histogram. Values recorded concurrently with the reset may be partially kept.
+     */
+    void reset();
+
+private:
+    static constexpr size_t STRIPE_COUNT = 8;
+
+    struct alignas(64) Stripe
+    {
+        void updateMin(uint64_t value)
+        {
+            uint64_t current = min.load(std::memory_order_relaxed);
+            while(value < current && !min.compare_exchange_weak(current, value, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        void updateMax(uint64_t value)
+        {
+            uint64_t current = max.load(std::memory_order_relaxed);
+            while(value > current && !max.compare_exchange_weak(current, value, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        std::atomic<uint64_t> sum = {0};
+        std::atomic<uint64_t> min = {UINT64_MAX};
+        std::atomic<uint64_t> max = {0};
+    };
+
+    // Threads are assigned stripes round-robin on their first record
+    static size_t stripeIndex()
+    {
+        static std::atomic<size_t> nextStripe = {0};
+        thread_local const size_t index = nextStripe.fetch_add(1, std::memory_order_relaxed) % STRIPE_COUNT;
+        return index;
+    }
+
+    std::array<std::atomic<uint64_t>, HistogramLayout::BUCKET_COUNT> m_buckets = {};
+    std::array<Stripe, STRIPE_COUNT> m_stripes;
+};
+
+}
+
+#endif
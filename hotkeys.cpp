@@ -0,0 +1,97 @@
+#include "hotkeys.h"
+
+namespace glfwW
+{
+
+HotkeyTable::HotkeyTable()
+{
+    m_slots.fill(EMPTY_SLOT);
+}
+
+bool HotkeyTable::bind(Key key, ModifierSet modifiers, Handler handler, bool repeat)
+{
+    size_t slot = 0;
+    if(!handler || !slotIndex(key, modifiers, slot))
+    {
+        return false;
+    }
+
+    if(m_slots[slot] != EMPTY_SLOT)
+    {
+        auto& binding = m_bindings[m_slots[slot]];
+        binding.repeat = repeat;
+        binding.handler = std::make_shared<const Handler>(std::move(handler));
+        return true;
+    }
+
+    Binding binding;
+    binding.slot = slot;
+    binding.repeat = repeat;
+    binding.handler = std::make_shared<const Handler>(std::move(handler));
+    m_slots[slot] = static_cast<uint16_t>(m_bindings.size());
+    m_bindings.push_back(std::move(binding));
+    return true;
+}
+
+bool HotkeyTable::unbind(Key key, ModifierSet modifiers)
+{
+    size_t slot = 0;
+    if(!slotIndex(key, modifiers, slot) || m_slots[slot] == EMPTY_SLOT)
+    {
+        return false;
+    }
+
+    // The last binding takes the place of the removed one
+    const uint16_t index = m_slots[slot];
+    if(index + 1u != m_bindings.size())
+    {
+        m_bindings[index] = std::move(m_bindings.back());
+        m_slots[m_bindings[index].slot] = index;
+    }
+    m_bindings.pop_back();
+    m_slots[slot] = EMPTY_SLOT;
+    return true;
+}
+
+void HotkeyTable::clear()
+{
+    m_slots.fill(EMPTY_SLOT);
+    m_bindings.clear();
+}
+
+bool HotkeyTable::contains(Key key, ModifierSet modifiers) const
+{
+    size_t slot = 0;
+    return slotIndex(key, modifiers, slot) && m_slots[slot] != EMPTY_SLOT;
+}
+
+bool HotkeyTable::dispatch(const Window& window, const KeyEvent& event) const
+{
+    size_t slot = 0;
+    if(event.action == Action::RELEASE || !slotIndex(event.key, event.modifiers(), slot) || m_slots[slot] == EMPTY_SLOT)
+    {
+        return false;
+    }
+
+    const auto& binding = m_bindings[m_slots[slot]];
+    if(event.action == Action::REPEAT && !binding.repeat)
+    {
+        return false;
+    }
+    const auto handler = binding.handler;
+    (*handler)(window, event);
+    return true;
+}
+
+bool HotkeyTable::slotIndex(Key key, ModifierSet modifiers, size_t& slot)
+{
+    const auto keyIndex = static_cast<size_t>(key);
+    if(key == Key::KEY_UNKNOWN || keyIndex >= static_cast<size_t>(Key::KEY_LAST))
+    {
+        return false;
+    }
+    slot = keyIndex * MODIFIER_COMBINATIONS + static_cast<size_t>(modifiers.withoutLocks().toGlfwBits());
+    return true;
+}
+
+}
@@ -0,0 +1,71 @@
+#ifndef GLFWW_HOTKEYS_H
+#define GLFWW_HOTKEYS_H
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "events.h"
+#include "window.h"
+
+namespace glfwW
+{
+
+/*!
+ * \brief Maps key chords (a key with SHIFT, CONTROL, ALT and SUPER modifiers) to handlers.
+ * A chord is looked up in constant time through a table indexed by the key and the modifier bits,
+ * so a key event costs one table access whatever the number of hotkeys.
+ * CAPS_LOCK and NUM_LOCK are ignored when chords are bound and matched.
+ */
+class HotkeyTable
+{
+public:
+    using Handler = std::function<void(const Window&, KeyEvent)>;
+
+    HotkeyTable();
+
+    /*!
+     * \brief Binds the handler to the chord, replacing the previous binding.
+     * If repeat is true, the handler is also called for REPEAT actions while the key is held.
+     * Returns false for KEY_UNKNOWN or an empty handler.
+     */
+    bool bind(Key key, ModifierSet modifiers, Handler handler, bool repeat = false);
+
+    bool unbind(Key key, ModifierSet modifiers);
+
+    void clear();
+
+    bool contains(Key key, ModifierSet modifiers) const;
+
+    size_t size() const {return m_bindings.size();}
+
+    /*!
+     * \brief Calls the handler bound to the chord of the event. Returns true if a handler was called.
+     * Can be used directly as a Window::KeyHandler body. The handler may bind and unbind hotkeys, including its own.
+     */
+    bool dispatch(const Window& window, const KeyEvent& event) const;
+
+private:
+    // Chord modifiers are SHIFT, CONTROL, ALT and SUPER
+    static constexpr size_t MODIFIER_COMBINATIONS = 16;
+    static constexpr size_t SLOT_COUNT = static_cast<size_t>(Key::KEY_LAST) * MODIFIER_COMBINATIONS;
+    static constexpr uint16_t EMPTY_SLOT = UINT16_MAX;
+
+    struct Binding
+    {
+        size_t slot = 0;
+        bool repeat = false;
+        // Shared, so a handler stays alive while it runs even if it unbinds or rebinds its chord
+        std::shared_ptr<const Handler> handler;
+    };
+
+    static bool slotIndex(Key key, ModifierSet modifiers, size_t& slot);
+
+    std::array<uint16_t, SLOT_COUNT> m_slots;
+    std::vector<Binding> m_bindings;
+};
+
+}
+
+#endif
@@ -0,0 +1,206 @@
+#include "icon.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GLFWW_ICON_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace glfwW
+{
+
+namespace
+{
+
+/*!
+ * \brief Source pixels contributing to a destination pixel along one axis
+ */
+struct Contribution
+{
+    int first = 0;
+    std::vector<float> weights;
+};
+
+std::vector<Contribution> computeContributions(int sourceSize, int size)
+{
+    std::vector<Contribution> result(static_cast<size_t>(size));
+    const double scale = static_cast<double>(sourceSize) / size;
+    for(int i = 0; i < size; ++i)
+    {
+        const double begin = i * scale;
+        const double end = (i + 1) * scale;
+        auto& contribution = result[i];
+        contribution.first = std::min(static_cast<int>(begin), sourceSize - 1);
+        const int last = std::min(static_cast<int>(std::ceil(end)), sourceSize);
+        for(int j = contribution.first; j < std::max(last, contribution.first + 1); ++j)
+        {
+            const double overlap = std::min<double>(end, j + 1) - std::max<double>(begin, j);
+            contribution.weights.push_back(static_cast<float>(std::max(overlap, 0.0) / scale));
+        }
+    }
+    return result;
+}
+
+#ifdef GLFWW_ICON_SSE2
+
+__m128 loadPremultiplied(const unsigned char* pixel)
+{
+    const __m128 value = _mm_set_ps(pixel[3], pixel[2], pixel[1], pixel[0]);
+    const float alpha = pixel[3] * (1.0f / 255.0f);
+    return _mm_mul_ps(value, _mm_set_ps(1.0f, alpha, alpha, alpha));
+}
+
+void storeUnpremultiplied(__m128 value, unsigned char* pixel)
+{
+    alignas(16) float channels[4];
+    _mm_store_ps(channels, value);
+    const float scale = channels[3] > 0.0f ? 255.0f / channels[3] : 0.0f;
+    value = _mm_mul_ps(value, _mm_set_ps(1.0f, scale, scale, scale));
+    value = _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(255.0f));
+    // Rounds half up like the scalar path, instead of to even like _mm_cvtps_epi32
+    const __m128i rounded = _mm_cvttps_epi32(_mm_add_ps(value, _mm_set1_ps(0.5f)));
+    const __m128i words = _mm_packs_epi32(rounded, rounded);
+    const __m128i packed = _mm_packus_epi16(words, words);
+    const int bits = _mm_cvtsi128_si32(packed);
+    pixel[0] = static_cast<unsigned char>(bits);
+    pixel[1] = static_cast<unsigned char>(bits >> 8);
+    pixel[2] = static_cast<unsigned char>(bits >> 16);
+    pixel[3] = static_cast<unsigned char>(bits >> 24);
+}
+
+#endif
+
+}
+
+void resizeImage(const unsigned char* source, Vec2<int> sourceSize, unsigned char* destination, Vec2<int> size)
+{
+    if(!source || !destination || sourceSize.x <= 0 || sourceSize.y <= 0 || size.x <= 0 || size.y <= 0)
+    {
+        return;
+    }
+
+    const auto columns = computeContributions(sourceSize.x, size.x);
+    const auto rows = computeContributions(sourceSize.y, size.y);
+
+    // Horizontal pass into premultiplied floats, then vertical pass into the destination
+    std::vector<float> intermediate(static_cast<size_t>(size.x) * sourceSize.y * 4);
+
+#ifdef GLFWW_ICON_SSE2
+    for(int y = 0; y < sourceSize.y; ++y)
+    {
+        const unsigned char* sourceRow = source + static_cast<size_t>(y) * sourceSize.x * 4;
+        float* row = intermediate.data() + static_cast<size_t>(y) * size.x * 4;
+        for(int x = 0; x < size.x; ++x)
+        {
+            const auto& column = columns[x];
+            __m128 sum = _mm_setzero_ps();
+            for(size_t k = 0; k < column.weights.size(); ++k)
+            {
+                const __m128 pixel = loadPremultiplied(sourceRow + (column.first + k) * 4);
+                sum = _mm_add_ps(sum, _mm_mul_ps(pixel, _mm_set1_ps(column.weights[k])));
+            }
+            _mm_storeu_ps(row + x * 4, sum);
+        }
+    }
+
+    for(int y = 0; y < size.y; ++y)
+    {
+        const auto& sourceRows = rows[y];
+        unsigned char* destinationRow = destination + static_cast<size_t>(y) * size.x * 4;
+        for(int x = 0; x < size.x; ++x)
+        {
+            __m128 sum = _mm_setzero_ps();
+            for(size_t k = 0; k < sourceRows.weights.size(); ++k)
+            {
+                const float* pixel = intermediate.data() + ((sourceRows.first + k) * size.x + x) * 4;
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(pixel), _mm_set1_ps(sourceRows.weights[k])));
+            }
+            storeUnpremultiplied(sum, destinationRow + x * 4);
+        }
+    }
+#else
+    for(int y = 0; y < sourceSize.y; ++y)
+    {
+        const unsigned char* sourceRow = source + static_cast<size_t>(y) * sourceSize.x * 4;
+        float* row = intermediate.data() + static_cast<size_t>(y) * size.x * 4;
+        for(int x = 0; x < size.x; ++x)
+        {
+            const auto& column = columns[x];
+            float sum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+            for(size_t k = 0; k < column.weights.size(); ++k)
+            {
+                // Same operations in the same order as the SSE2 path, so both give the same results
+                const unsigned char* pixel = sourceRow + (column.first + k) * 4;
+                const float weight = column.weights[k];
+                const float alpha = pixel[3] * (1.0f / 255.0f);
+                sum[0] += pixel[0] * alpha * weight;
+                sum[1] += pixel[1] * alpha * weight;
+                sum[2] += pixel[2] * alpha * weight;
+                sum[3] += pixel[3] * weight;
+            }
+            std::copy(sum, sum + 4, row + x * 4);
+        }
+    }
+
+    for(int y = 0; y < size.y; ++y)
+    {
+        const auto& sourceRows = rows[y];
+        unsigned char* destinationRow = destination + static_cast<size_t>(y) * size.x * 4;
+        for(int x = 0; x < size.x; ++x)
+        {
+            float sum[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+            for(size_t k = 0; k < sourceRows.weights.size(); ++k)
+            {
+                const float* pixel = intermediate.data() + ((sourceRows.first + k) * size.x + x) * 4;
+                for(int c = 0; c < 4; ++c)
+                {
+                    sum[c] += pixel[c] * sourceRows.weights[k];
+                }
+            }
+            const float scale = sum[3] > 0.0f ? 255.0f / sum[3] : 0.0f;
+            for(int c = 0; c < 4; ++c)
+            {
+                const float value = c == 3 ? sum[c] : sum[c] * scale;
+                destinationRow[x * 4 + c] = static_cast<unsigned char>(std::min(std::max(value, 0.0f), 255.0f) + 0.5f);
+            }
+        }
+    }
+#endif
+}
+
+IconSet::IconSet(const unsigned char* rgbaPixels, Vec2<int> size, const std::vector<int>& sizes)
+{
+    if(!rgbaPixels || size.x <= 0 || size.y <= 0)
+    {
+        return;
+    }
+
+    std::vector<int> iconSizes;
+    std::copy_if(sizes.begin(), sizes.end(), std::back_inserter(iconSizes), [](int s){return s > 0;});
+    std::sort(iconSizes.begin(), iconSizes.end());
+    iconSizes.erase(std::unique(iconSizes.begin(), iconSizes.end()), iconSizes.end());
+
+    size_t arenaSize = 0;
+    for(const int iconSize : iconSizes)
+    {
+        arenaSize += static_cast<size_t>(iconSize) * iconSize * 4;
+    }
+    m_arena.resize(arenaSize);
+
+    // The arena is never resized after this point, so the images can point into it
+    size_t offset = 0;
+    for(const int iconSize : iconSizes)
+    {
+        GLFWimage image;
+        image.width = iconSize;
+        image.height = iconSize;
+        image.pixels = m_arena.data() + offset;
+        resizeImage(rgbaPixels, size, image.pixels, {iconSize, iconSize});
+        m_images.push_back(image);
+        offset += static_cast<size_t>(iconSize) * iconSize * 4;
+    }
+}
+
+}
@@ -0,0 +1,56 @@
+#ifndef GLFWW_ICON_H
+#define GLFWW_ICON_H
+
+#include <vector>
+#include "defs.h"
+
+namespace glfwW
+{
+
+/*!
+ * \brief Downscales an RGBA image with an area (box) filter on premultiplied alpha.
+ * The destination has to hold size.x * size.y * 4 bytes.
+ */
+void resizeImage(const unsigned char* source, Vec2<int> sourceSize, unsigned char* destination, Vec2<int> size);
+
+/*!
+ * \brief A set of window icons generated once from a single source image.
+ * All images are stored in one arena, so the set can be applied to any number of windows without copies.
+ */
+class IconSet
+{
+public:
+    /*!
+     * \brief Sizes requested by the common desktop environments
+     */
+    static std::vector<int> standardSizes()
+    {
+        return {16, 32, 48, 256};
+    }
+
+    IconSet() = default;
+    IconSet(const IconSet&) = delete;
+    IconSet(IconSet&&) = default;
+    IconSet& operator=(const IconSet&) = delete;
+    IconSet& operator=(IconSet&&) = default;
+
+    /*!
+     * \brief Generates square icons of the given sizes from decoded RGBA pixels.
+     */
+    IconSet(const unsigned char* rgbaPixels, Vec2<int> size, const std::vector<int>& sizes = standardSizes());
+
+    bool empty() const {return m_images.empty();}
+
+    /*!
+     * \brief Returns the icons in ascending size. Pixels point into the set's arena.
+     */
+    const std::vector<GLFWimage>& images() const {return m_images;}
+
+private:
+    std::vector<unsigned char> m_arena;
+    std::vector<GLFWimage> m_images;
+};
+
+}
+
+#endif
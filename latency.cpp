@@ -0,0 +1,63 @@
+#include "latency.h"
+
+namespace glfwW
+{
+
+LatencyTracker::LatencyTracker(uint64_t timerFrequency):
+    m_timerFrequency(timerFrequency ? timerFrequency : 1)
+{
+    m_pendingEvents.reserve(MAX_PENDING_EVENTS);
+}
+
+void LatencyTracker::onEvent(uint64_t timestamp)
+{
+    if(m_pendingEvents.size() == MAX_PENDING_EVENTS)
+    {
+        ++m_droppedEvents;
+        return;
+    }
+    m_pendingEvents.push_back(timestamp);
+}
+
+void LatencyTracker::onSwap(uint64_t timestamp)
+{
+    for(const auto eventTimestamp : m_pendingEvents)
+    {
+        m_eventToSwap.record(timestamp > eventTimestamp ? toMicroseconds(timestamp - eventTimestamp) : 0);
+    }
+    m_pendingEvents.clear();
+
+    if(m_hasSwapped)
+    {
+        m_frameInterval.record(timestamp > m_lastSwap ? toMicroseconds(timestamp - m_lastSwap) : 0);
+    }
+    m_lastSwap = timestamp;
+    m_hasSwapped = true;
+}
+
+LatencyStatistics LatencyTracker::statistics() const
+{
+    LatencyStatistics result;
+    m_eventToSwap.snapshot(result.eventToSwap);
+    m_frameInterval.snapshot(result.frameInterval);
+    result.pendingEvents = m_pendingEvents.size();
+    result.droppedEvents = m_droppedEvents;
+    return result;
+}
+
+void LatencyTracker::reset()
+{
+    m_pendingEvents.clear();
+    m_droppedEvents = 0;
+    m_hasSwapped = false;
+    m_eventToSwap.reset();
+    m_frameInterval.reset();
+}
+
+uint64_t LatencyTracker::toMicroseconds(uint64_t ticks) const
+{
+    // Split to avoid overflowing the multiplication for long intervals
+    return ticks / m_timerFrequency * 1000000 + ticks % m_timerFrequency * 1000000 / m_timerFrequency;
+}
+
+}
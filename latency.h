@@ -0,0 +1,76 @@
+#ifndef GLFWW_LATENCY_H
+#define GLFWW_LATENCY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "histogram.h"
+
+namespace glfwW
+{
+
+/*!
+ * \brief Latency measurements in microseconds
+ */
+struct LatencyStatistics
+{
+    /*!
+     * \brief Time from the arrival of an input event to the end of the next buffer swap of its window
+     */
+    HistogramSnapshot eventToSwap;
+    /*!
+     * \brief Time between the ends of consecutive buffer swaps
+     */
+    HistogramSnapshot frameInterval;
+    /*!
+     * \brief Events that arrived after the last swap and wait for the next one
+     */
+    uint64_t pendingEvents = 0;
+    /*!
+     * \brief Events that weren't measured because LatencyTracker::MAX_PENDING_EVENTS events were already waiting for a swap
+     */
+    uint64_t droppedEvents = 0;
+};
+
+/*!
+ * \brief Attributes input events to the buffer swap that presents them and measures the delays.
+ * Timestamps are timer values (e.g. of glfwGetTimerValue) in ticks of the frequency given to the constructor,
+ * so recorded sequences can be replayed in tests.
+ */
+class LatencyTracker
+{
+public:
+    /*!
+     * \brief Events arriving while this many wait for a swap are only counted, so a window which never swaps
+     * (e.g. one without an OpenGL context) doesn't grow the tracker.
+     */
+    static constexpr size_t MAX_PENDING_EVENTS = 1024;
+
+    explicit LatencyTracker(uint64_t timerFrequency);
+
+    void onEvent(uint64_t timestamp);
+
+    /*!
+     * \brief Records a swap that ended at the timestamp. Every event since the previous swap is attributed to it.
+     */
+    void onSwap(uint64_t timestamp);
+
+    LatencyStatistics statistics() const;
+
+    void reset();
+
+private:
+    uint64_t toMicroseconds(uint64_t ticks) const;
+
+    uint64_t m_timerFrequency = 1;
+    std::vector<uint64_t> m_pendingEvents;
+    uint64_t m_droppedEvents = 0;
+    uint64_t m_lastSwap = 0;
+    bool m_hasSwapped = false;
+    Histogram m_eventToSwap;
+    Histogram m_frameInterval;
+};
+
+}
+
+#endif
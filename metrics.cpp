@@ -0,0 +1,24 @@
+#include "metrics.h"
+
+namespace glfwW
+{
+
+void Metrics::setEnabled(bool enabled)
+{
+    if(enabled)
+    {
+        const uint64_t frequency = glfwGetTimerFrequency();
+        m_nanosecondsPerTick.store(frequency ? 1e9 / static_cast<double>(frequency) : 1.0, std::memory_order_relaxed);
+    }
+    // The release store publishes the tick length to the threads seeing the flag
+    m_enabled.store(enabled, std::memory_order_release);
+}
+
+void Metrics::reset()
+{
+    callbackDispatch.reset();
+    eventProcessing.reset();
+    bufferSwap.reset();
+}
+
+}
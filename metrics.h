@@ -0,0 +1,89 @@
+#ifndef GLFWW_METRICS_H
+#define GLFWW_METRICS_H
+
+#include <atomic>
+#include "defs.h"
+#include "histogram.h"
+
+namespace glfwW
+{
+
+/*!
+ * \brief Timings of the wrapper's hot paths in nanoseconds.
+ * Recording is disabled by default, and then costs an atomic load per instrumented call.
+ */
+class Metrics
+{
+public:
+    static Metrics& instance()
+    {
+        static Metrics inst;
+        return inst;
+    }
+
+    /*!
+     * \brief Enables recording. GLFW has to be initialized, since the timer frequency is queried from it.
+     */
+    void setEnabled(bool enabled);
+
+    bool enabled() const {return m_enabled.load(std::memory_order_acquire);}
+
+    uint64_t toNanoseconds(uint64_t ticks) const
+    {
+        return static_cast<uint64_t>(ticks * m_nanosecondsPerTick.load(std::memory_order_relaxed));
+    }
+
+    void reset();
+
+    /*!
+     * \brief Duration of a call of a window event handler
+     */
+    Histogram callbackDispatch;
+    /*!
+     * \brief Duration of GLFWlibrary::pollEvents, including the dispatch of the events
+     */
+    Histogram eventProcessing;
+    /*!
+     * \brief Duration of Window::swapBuffers
+     */
+    Histogram bufferSwap;
+
+private:
+    Metrics() = default;
+
+    std::atomic<bool> m_enabled = {false};
+    // Atomic, since enabling again rewrites it while other threads record
+    std::atomic<double> m_nanosecondsPerTick = {1.0};
+};
+
+/*!
+ * \brief Records its lifetime into the histogram if metrics were enabled when it was created
+ */
+class MetricsTimer
+{
+public:
+    explicit MetricsTimer(Histogram& histogram):
+        m_histogram(Metrics::instance().enabled() ? &histogram : nullptr),
+        m_start(m_histogram ? glfwGetTimerValue() : 0)
+    {
+    }
+
+    MetricsTimer(const MetricsTimer&) = delete;
+    MetricsTimer& operator=(const MetricsTimer&) = delete;
+
+    ~MetricsTimer()
+    {
+        if(m_histogram)
+        {
+            m_histogram->record(Metrics::instance().toNanoseconds(glfwGetTimerValue() - m_start));
+        }
+    }
+
+private:
+    Histogram* m_histogram = nullptr;
+    uint64_t m_start = 0;
+};
+
+}
+
+#endif
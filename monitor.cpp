@@ -1,28 +1,106 @@
 #include "monitor.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <tuple>
 
 namespace glfwW
 {
 
+std::unordered_map<GLFWmonitor*, std::vector<VideoMode>> Monitor::videoModes;
+std::unordered_map<GLFWmonitor*, Monitor::GammaState> Monitor::gammaStates;
+
+namespace
+{
+
+int bitDepth(const VideoMode& mode)
+{
+    return mode.redBits + mode.greenBits + mode.blueBits;
+}
+
+bool sizeLess(const VideoMode& mode, Vec2<int> size)
+{
+    return std::tie(mode.width, mode.height) < std::tie(size.x, size.y);
+}
+
+bool sizeGreater(Vec2<int> size, const VideoMode& mode)
+{
+    return std::tie(size.x, size.y) < std::tie(mode.width, mode.height);
+}
+
+}
+
 VideoMode Monitor::getVideoMode() const
 {
     return m_monitor ? VideoMode(*glfwGetVideoMode(m_monitor)) : VideoMode();
 }
 
-std::vector<VideoMode> Monitor::getVideoModes() const
+Span<const VideoMode> Monitor::getVideoModes() const
 {
-    std::vector<VideoMode> result;
-    int count = 0;
+    const auto& modes = cachedVideoModes();
+    return {modes.data(), modes.size()};
+}
+
+Span<const VideoMode> Monitor::findVideoModes(Vec2<int> size) const
+{
+    const auto& modes = cachedVideoModes();
+    const auto first = std::lower_bound(modes.begin(), modes.end(), size, sizeLess);
+    const auto last = std::upper_bound(first, modes.end(), size, sizeGreater);
+    return {modes.data() + (first - modes.begin()), static_cast<size_t>(last - first)};
+}
 
+const VideoMode* Monitor::findHighestRefreshRate(Vec2<int> size) const
+{
+    const auto modes = findVideoModes(size);
+    return modes.empty() ? nullptr : &modes.back();
+}
+
+const VideoMode* Monitor::findClosestVideoMode(Vec2<int> size, int refreshRate) const
+{
+    // Lower ranks are better. Modes are sorted, so on ties the smaller size and the lower refresh rate win.
+    const auto rank = [size, refreshRate](const VideoMode& mode){
+        const int64_t sizeDistance = std::abs(static_cast<int64_t>(mode.width) - size.x) +
+                                     std::abs(static_cast<int64_t>(mode.height) - size.y);
+        const int rateDistance = refreshRate > 0 ? std::abs(mode.refreshRate - refreshRate) : -mode.refreshRate;
+        return std::make_tuple(sizeDistance, rateDistance, -bitDepth(mode));
+    };
+
+    const VideoMode* result = nullptr;
+    for(const auto& mode : cachedVideoModes())
+    {
+        if(!result || rank(mode) < rank(*result))
+        {
+            result = &mode;
+        }
+    }
+    return result;
+}
+
+const std::vector<VideoMode>& Monitor::cachedVideoModes() const
+{
+    auto itr = videoModes.find(m_monitor);
+    if(itr != videoModes.end())
+    {
+        return itr->second;
+    }
+
+    std::vector<VideoMode> result;
     if(m_monitor)
     {
+        int count = 0;
         const GLFWvidmode* modes = glfwGetVideoModes(m_monitor, &count);
+        result.reserve(static_cast<size_t>(std::max(count, 0)));
         for(int i = 0; i < count; ++i)
         {
-            result.push_back(VideoMode(modes[i]));
+            result.emplace_back(modes[i]);
         }
+        std::sort(result.begin(), result.end(), [](const VideoMode& lhs, const VideoMode& rhs){
+            return std::make_tuple(lhs.width, lhs.height, lhs.refreshRate, bitDepth(lhs)) <
+                   std::make_tuple(rhs.width, rhs.height, rhs.refreshRate, bitDepth(rhs));
+        });
     }
-
-    return result;
+    return videoModes.emplace(m_monitor, std::move(result)).first->second;
 }
 
 Vec2<int> Monitor::getPhysicalSize() const
@@ -83,4 +161,94 @@ void* Monitor::getUserPointer() const
     return m_monitor ? glfwGetMonitorUserPointer(m_monitor) : nullptr;
 }
 
+void Monitor::setGamma(float gamma)
+{
+    GammaParameters parameters;
+    parameters.gamma = gamma;
+    setGamma(parameters);
+}
+
+void Monitor::setGamma(const GammaParameters& parameters)
+{
+    if(!m_monitor || parameters.gamma <= 0.0f)
+    {
+        return;
+    }
+
+    auto& state = gammaState();
+    if(state.original.empty())
+    {
+        return;
+    }
+
+    auto itr = std::find_if(state.ramps.begin(), state.ramps.end(), [&parameters](const auto& entry){
+        return entry.first == parameters;
+    });
+    if(itr == state.ramps.end())
+    {
+        GammaRamp ramp;
+        if(state.ramps.size() >= GammaState::CACHE_SIZE)
+        {
+            // Reuse the tables of the least recently used ramp
+            ramp = std::move(state.ramps.front().second);
+            state.ramps.erase(state.ramps.begin());
+        }
+        const size_t size = state.original.size();
+        ramp.red.resize(size);
+        buildGammaCurve(parameters, ramp.red.data(), size);
+        ramp.green = ramp.red;
+        ramp.blue = ramp.red;
+        state.ramps.emplace_back(parameters, std::move(ramp));
+        itr = std::prev(state.ramps.end());
+    }
+    else
+    {
+        std::rotate(itr, std::next(itr), state.ramps.end());
+        itr = std::prev(state.ramps.end());
+    }
+
+    const GLFWgammaramp ramp = itr->second.toGlfwGammaRamp();
+    glfwSetGammaRamp(m_monitor, &ramp);
+}
+
+GammaRamp Monitor::getGammaRamp() const
+{
+    const GLFWgammaramp* ramp = m_monitor ? glfwGetGammaRamp(m_monitor) : nullptr;
+    return ramp ? GammaRamp(*ramp) : GammaRamp();
+}
+
+void Monitor::setGammaRamp(const GammaRamp& ramp)
+{
+    if(!m_monitor || ramp.empty())
+    {
+        return;
+    }
+    assert(ramp.green.size() == ramp.size() && ramp.blue.size() == ramp.size());
+
+    gammaState();
+    const GLFWgammaramp glfwRamp = ramp.toGlfwGammaRamp();
+    glfwSetGammaRamp(m_monitor, &glfwRamp);
+}
+
+void Monitor::restoreGammaRamp()
+{
+    auto itr = gammaStates.find(m_monitor);
+    if(itr != gammaStates.end() && !itr->second.original.empty())
+    {
+        const GLFWgammaramp ramp = itr->second.original.toGlfwGammaRamp();
+        glfwSetGammaRamp(m_monitor, &ramp);
+    }
+}
+
+Monitor::GammaState& Monitor::gammaState() const
+{
+    auto itr = gammaStates.find(m_monitor);
+    if(itr == gammaStates.end())
+    {
+        itr = gammaStates.emplace(m_monitor, GammaState()).first;
+        itr->second.original = getGammaRamp();
+    }
+    return itr->second;
+}
+
 }
@@ -3,7 +3,9 @@
 
 #include <vector>
 #include <string>
+#include <unordered_map>
 #include "defs.h"
+#include "gamma.h"
 
 namespace glfwW
 {
@@ -66,9 +68,27 @@ public:
     VideoMode getVideoMode() const;
 
     /*!
-     * \brief Returns available video modes for the monitor.
+     * \brief Returns available video modes for the monitor, sorted by width, height, refresh rate and bit depth.
+     * The modes are cached until a monitor is connected or disconnected. The span is valid until then.
      */
-    std::vector<VideoMode> getVideoModes() const;
+    Span<const VideoMode> getVideoModes() const;
+
+    /*!
+     * \brief Returns all video modes with the given size, sorted by refresh rate and bit depth.
+     */
+    Span<const VideoMode> findVideoModes(Vec2<int> size) const;
+
+    /*!
+     * \brief Returns the mode with the highest refresh rate at the given size, or nullptr if there is no such mode.
+     */
+    const VideoMode* findHighestRefreshRate(Vec2<int> size) const;
+
+    /*!
+     * \brief Returns the mode closest to the target, or nullptr if the monitor has no modes.
+     * Modes are ranked by the sum of their width and height differences, then by the closest refresh rate
+     * and then by the highest bit depth. A refresh rate of 0 selects the highest one.
+     */
+    const VideoMode* findClosestVideoMode(Vec2<int> size, int refreshRate = 0) const;
 
     /*!
      * \brief Returns the physical size of a monitor in millimetres.
@@ -110,8 +130,71 @@ public:
 
     bool isValid() const {return m_monitor;}
 
-    //TODO gamma ramp
+    /*!
+     * \brief Sets a gamma ramp generated from the exponent, like glfwSetGamma.
+     */
+    void setGamma(float gamma);
+
+    /*!
+     * \brief Sets a gamma ramp generated from the parameters with the monitor's ramp size.
+     * Recently used ramps are cached per monitor, so animations going through the same parameters don't rebuild them.
+     */
+    void setGamma(const GammaParameters& parameters);
+
+    /*!
+     * \brief Returns the current gamma ramp. The ramp is empty if the monitor doesn't support gamma.
+     */
+    GammaRamp getGammaRamp() const;
+
+    /*!
+     * \brief Sets the gamma ramp. Its size has to match the size of the current ramp.
+     */
+    void setGammaRamp(const GammaRamp& ramp);
+
+    /*!
+     * \brief Restores the ramp the monitor had before it was first changed through this wrapper.
+     */
+    void restoreGammaRamp();
+
 private:
+    struct GammaState
+    {
+        static constexpr size_t CACHE_SIZE = 16;
+
+        /*!
+         * \brief The ramp before the first change
+         */
+        GammaRamp original;
+        /*!
+         * \brief Recently built ramps, the most recently used last
+         */
+        std::vector<std::pair<GammaParameters, GammaRamp>> ramps;
+    };
+
+    /*!
+     * \brief Drops cached video modes of all monitors and the gamma state of a disconnected one.
+     */
+    static void onMonitorEvent(GLFWmonitor* monitor, bool connected)
+    {
+        videoModes.clear();
+        if(!connected)
+        {
+            gammaStates.erase(monitor);
+        }
+    }
+
+    static void clearCaches()
+    {
+        videoModes.clear();
+        gammaStates.clear();
+    }
+
+    const std::vector<VideoMode>& cachedVideoModes() const;
+    GammaState& gammaState() const;
+
+    static std::unordered_map<GLFWmonitor*, std::vector<VideoMode>> videoModes;
+    static std::unordered_map<GLFWmonitor*, GammaState> gammaStates;
+
     GLFWmonitor* m_monitor = nullptr;
 };
 
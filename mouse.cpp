@@ -1,42 +1,83 @@
 #include "mouse.h"
+#include <atomic>
+#include <initializer_list>
+
+#ifndef GLFWW_INLINE_HOT_PATH
+#include "mouse.inl"
+#endif
 
 namespace glfwW
 {
 
-int toGlfwCursorMode(CursorMode mode)
+namespace
 {
-    int result = GLFW_CURSOR_NORMAL;
 
-    switch(mode)
+// Incremented when GLFW is terminated, cursors of older generations are already destroyed
+std::atomic<unsigned> cursorGeneration = {1};
+
+}
+
+Cursor::Cursor(GLFWcursor* cursor):
+      m_generation(cursorGeneration.load(std::memory_order_relaxed))
+{
+    if(cursor)
     {
-    case CursorMode::NORMAL:
-        result = GLFW_CURSOR_NORMAL;
-        break;
-    case CursorMode::HIDDEN:
-        result = GLFW_CURSOR_HIDDEN;
-        break;
-    case CursorMode::DISABLED:
-        result = GLFW_CURSOR_DISABLED;
-        break;
+        m_cursor.reset(cursor, [generation = m_generation](GLFWcursor* cursor){
+            if(generation == cursorGeneration.load(std::memory_order_relaxed))
+            {
+                glfwDestroyCursor(cursor);
+            }
+        });
     }
-    return result;
 }
 
-CursorMode fromGlfwCursorMode(int mode)
+bool Cursor::valid() const
 {
-    if(mode == GLFW_CURSOR_NORMAL)
+    return m_cursor && m_generation == cursorGeneration.load(std::memory_order_relaxed);
+}
+
+GLFWcursor* Cursor::getHandler() const
+{
+    return valid() ? m_cursor.get() : nullptr;
+}
+
+void invalidateCursors()
+{
+    cursorGeneration.fetch_add(1, std::memory_order_relaxed);
+}
+
+size_t CursorKeyHash::operator()(const CursorKey& key) const
+{
+    uint64_t result = key.imageHash;
+    for(const int value : {key.size.x, key.size.y, key.hotspot.x, key.hotspot.y, key.standardShape})
     {
-        return CursorMode::NORMAL;
+        result = (result ^ static_cast<uint32_t>(value)) * 0x100000001B3ull;
     }
-    else if(mode == GLFW_CURSOR_HIDDEN)
+    return static_cast<size_t>(result);
+}
+
+uint64_t hashImage(const GLFWimage& image)
+{
+    uint64_t result = 0xCBF29CE484222325ull;
+    const auto mix = [&result](unsigned char byte){
+        result = (result ^ byte) * 0x100000001B3ull;
+    };
+    for(const int value : {image.width, image.height})
     {
-        return CursorMode::HIDDEN;
+        for(int i = 0; i < 4; ++i)
+        {
+            mix(static_cast<unsigned char>(value >> (i * 8)));
+        }
     }
-    else if(mode == GLFW_CURSOR_DISABLED)
+    if(image.pixels && image.width > 0 && image.height > 0)
     {
-        return CursorMode::DISABLED;
+        const size_t size = static_cast<size_t>(image.width) * image.height * 4;
+        for(size_t i = 0; i < size; ++i)
+        {
+            mix(image.pixels[i]);
+        }
     }
-    return CursorMode::NORMAL;
+    return result;
 }
 
 }
@@ -1,6 +1,9 @@
 #ifndef GLFWW_MOUSE_H
 #define GLFWW_MOUSE_H
 
+#include <cstdint>
+#include <memory>
+#include <vector>
 #include "defs.h"
 
 namespace glfwW
@@ -13,9 +16,93 @@ enum class CursorMode
     DISABLED
 };
 
-int toGlfwCursorMode(CursorMode mode);
-CursorMode fromGlfwCursorMode(int mode);
+GLFWW_CONSTEXPR int toGlfwCursorMode(CursorMode mode);
+GLFWW_CONSTEXPR CursorMode fromGlfwCursorMode(int mode);
+
+enum class StandardCursorShape
+{
+    ARROW,
+    IBEAM,
+    CROSSHAIR,
+    HAND,
+    HRESIZE,
+    VRESIZE
+};
+
+GLFWW_CONSTEXPR int toGlfwCursorShape(StandardCursorShape shape);
+
+/*!
+ * \brief A reference-counted handle to a cursor object.
+ * The native cursor is destroyed when the last handle and the library cache release it.
+ * Handles outliving the termination of the library become invalid, GLFW has destroyed their cursors.
+ */
+class Cursor
+{
+    friend class GLFWlibrary;
+
+public:
+    Cursor() = default;
+
+    bool valid() const;
+
+    GLFWcursor* getHandler() const;
+
+    bool operator==(const Cursor& rhs) const {return m_cursor == rhs.m_cursor;}
+    bool operator!=(const Cursor& rhs) const {return m_cursor != rhs.m_cursor;}
+
+private:
+    explicit Cursor(GLFWcursor* cursor);
+
+    std::shared_ptr<GLFWcursor> m_cursor;
+    unsigned m_generation = 0;
+};
+
+/*!
+ * \brief Invalidates all cursor handles. Has to be called when GLFW is terminated, since that destroys all cursors.
+ */
+void invalidateCursors();
+
+/*!
+ * \brief Identifies a cursor inside the library cursor cache. Image cursors with colliding hashes share a key,
+ * their pixels are kept in CachedCursor.
+ */
+struct CursorKey
+{
+    uint64_t imageHash = 0;
+    Vec2<int> size;
+    Vec2<int> hotspot;
+    int standardShape = -1;
+
+    bool operator==(const CursorKey& rhs) const
+    {
+        return imageHash == rhs.imageHash && size.x == rhs.size.x && size.y == rhs.size.y &&
+               hotspot.x == rhs.hotspot.x && hotspot.y == rhs.hotspot.y && standardShape == rhs.standardShape;
+    }
+};
+
+/*!
+ * \brief A cursor of the library cursor cache with a copy of its pixels, which is only compared when the keys match.
+ */
+struct CachedCursor
+{
+    std::vector<unsigned char> pixels;
+    Cursor cursor;
+};
+
+struct CursorKeyHash
+{
+    size_t operator()(const CursorKey& key) const;
+};
+
+/*!
+ * \brief Returns a 64-bit FNV-1a hash of the image size and pixels.
+ */
+uint64_t hashImage(const GLFWimage& image);
 
 }
 
+#ifdef GLFWW_INLINE_HOT_PATH
+#include "mouse.inl"
+#endif
+
 #endif
@@ -0,0 +1,67 @@
+#ifndef GLFWW_MOUSE_INL
+#define GLFWW_MOUSE_INL
+
+#include "mouse.h"
+
+namespace glfwW
+{
+
+GLFWW_CONSTEXPR int toGlfwCursorMode(CursorMode mode)
+{
+    int result = GLFW_CURSOR_NORMAL;
+
+    switch(mode)
+    {
+    case CursorMode::NORMAL:
+        result = GLFW_CURSOR_NORMAL;
+        break;
+    case CursorMode::HIDDEN:
+        result = GLFW_CURSOR_HIDDEN;
+        break;
+    case CursorMode::DISABLED:
+        result = GLFW_CURSOR_DISABLED;
+        break;
+    }
+    return result;
+}
+
+GLFWW_CONSTEXPR CursorMode fromGlfwCursorMode(int mode)
+{
+    if(mode == GLFW_CURSOR_NORMAL)
+    {
+        return CursorMode::NORMAL;
+    }
+    else if(mode == GLFW_CURSOR_HIDDEN)
+    {
+        return CursorMode::HIDDEN;
+    }
+    else if(mode == GLFW_CURSOR_DISABLED)
+    {
+        return CursorMode::DISABLED;
+    }
+    return CursorMode::NORMAL;
+}
+
+GLFWW_CONSTEXPR int toGlfwCursorShape(StandardCursorShape shape)
+{
+    switch(shape)
+    {
+    case StandardCursorShape::ARROW:
+        return GLFW_ARROW_CURSOR;
+    case StandardCursorShape::IBEAM:
+        return GLFW_IBEAM_CURSOR;
+    case StandardCursorShape::CROSSHAIR:
+        return GLFW_CROSSHAIR_CURSOR;
+    case StandardCursorShape::HAND:
+        return GLFW_HAND_CURSOR;
+    case StandardCursorShape::HRESIZE:
+        return GLFW_HRESIZE_CURSOR;
+    case StandardCursorShape::VRESIZE:
+        return GLFW_VRESIZE_CURSOR;
+    }
+    return GLFW_ARROW_CURSOR;
+}
+
+}
+
+#endif
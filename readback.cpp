@@ -0,0 +1,267 @@
+#include "readback.h"
+#include <cstddef>
+#include <cstring>
+
+#if defined(_WIN32)
+#define GLFWW_GLAPIENTRY __stdcall
+#else
+#define GLFWW_GLAPIENTRY
+#endif
+
+namespace glfwW
+{
+
+namespace
+{
+
+const unsigned int PIXEL_PACK_BUFFER = 0x88EB;
+const unsigned int STREAM_READ = 0x88E1;
+const unsigned int MAP_READ_BIT = 0x0001;
+const unsigned int SYNC_GPU_COMMANDS_COMPLETE = 0x9117;
+const unsigned int SYNC_FLUSH_COMMANDS_BIT = 0x00000001;
+const unsigned int ALREADY_SIGNALED = 0x911A;
+const unsigned int CONDITION_SATISFIED = 0x911C;
+const uint64_t WAIT_FOREVER = 0xFFFFFFFFFFFFFFFFull;
+
+struct GLFunctions
+{
+    void (GLFWW_GLAPIENTRY* genBuffers)(int, unsigned int*) = nullptr;
+    void (GLFWW_GLAPIENTRY* deleteBuffers)(int, const unsigned int*) = nullptr;
+    void (GLFWW_GLAPIENTRY* bindBuffer)(unsigned int, unsigned int) = nullptr;
+    void (GLFWW_GLAPIENTRY* bufferData)(unsigned int, ptrdiff_t, const void*, unsigned int) = nullptr;
+    void* (GLFWW_GLAPIENTRY* mapBufferRange)(unsigned int, ptrdiff_t, ptrdiff_t, unsigned int) = nullptr;
+    unsigned char (GLFWW_GLAPIENTRY* unmapBuffer)(unsigned int) = nullptr;
+    void* (GLFWW_GLAPIENTRY* fenceSync)(unsigned int, unsigned int) = nullptr;
+    unsigned int (GLFWW_GLAPIENTRY* clientWaitSync)(void*, unsigned int, uint64_t) = nullptr;
+    void (GLFWW_GLAPIENTRY* deleteSync)(void*) = nullptr;
+
+    bool load()
+    {
+        genBuffers = reinterpret_cast<decltype(genBuffers)>(glfwGetProcAddress("glGenBuffers"));
+        deleteBuffers = reinterpret_cast<decltype(deleteBuffers)>(glfwGetProcAddress("glDeleteBuffers"));
+        bindBuffer = reinterpret_cast<decltype(bindBuffer)>(glfwGetProcAddress("glBindBuffer"));
+        bufferData = reinterpret_cast<decltype(bufferData)>(glfwGetProcAddress("glBufferData"));
+        mapBufferRange = reinterpret_cast<decltype(mapBufferRange)>(glfwGetProcAddress("glMapBufferRange"));
+        unmapBuffer = reinterpret_cast<decltype(unmapBuffer)>(glfwGetProcAddress("glUnmapBuffer"));
+        fenceSync = reinterpret_cast<decltype(fenceSync)>(glfwGetProcAddress("glFenceSync"));
+        clientWaitSync = reinterpret_cast<decltype(clientWaitSync)>(glfwGetProcAddress("glClientWaitSync"));
+        deleteSync = reinterpret_cast<decltype(deleteSync)>(glfwGetProcAddress("glDeleteSync"));
+        return genBuffers && deleteBuffers && bindBuffer && bufferData && mapBufferRange && unmapBuffer &&
+               fenceSync && clientWaitSync && deleteSync;
+    }
+};
+
+// Reloaded by every reader, all contexts of the process are expected to come from the same driver
+GLFunctions gl;
+
+}
+
+AsyncReadback::AsyncReadback(const Window& window, PixelFormat format, int bufferCount):
+      m_window(window.getHandler()), m_format(format)
+{
+    assert(isContextCurrent(m_window));
+    assert(bufferCount >= 2);
+
+    m_valid = m_window && gl.load();
+    if(!m_valid)
+    {
+        return;
+    }
+
+    m_slots.resize(static_cast<size_t>(std::max(bufferCount, 2)));
+    for(auto& slot : m_slots)
+    {
+        gl.genBuffers(1, &slot.buffer);
+    }
+}
+
+AsyncReadback::~AsyncReadback()
+{
+    if(!m_valid)
+    {
+        return;
+    }
+    for(auto& slot : m_slots)
+    {
+        if(slot.fence)
+        {
+            gl.deleteSync(slot.fence);
+        }
+        gl.deleteBuffers(1, &slot.buffer);
+    }
+}
+
+void AsyncReadback::setFrameHandler(FrameHandler h)
+{
+    m_frameHandler = h;
+}
+
+bool AsyncReadback::capture()
+{
+    if(!m_valid)
+    {
+        return false;
+    }
+    assert(isContextCurrent(m_window));
+
+    collect();
+
+    Slot& slot = m_slots[m_nextSlot];
+    if(slot.fence && !collectSlot(slot, false))
+    {
+        ++m_droppedFrames;
+        return false;
+    }
+
+    int width = 0;
+    int height = 0;
+    glfwGetFramebufferSize(m_window, &width, &height);
+    const size_t size = static_cast<size_t>(width) * static_cast<size_t>(height) * bytesPerPixel(m_format);
+    if(size == 0)
+    {
+        return false;
+    }
+
+    gl.bindBuffer(PIXEL_PACK_BUFFER, slot.buffer);
+    if(slot.capacity < size)
+    {
+        gl.bufferData(PIXEL_PACK_BUFFER, static_cast<ptrdiff_t>(size), nullptr, STREAM_READ);
+        slot.capacity = size;
+    }
+
+    GLint packAlignment = 4;
+    glGetIntegerv(GL_PACK_ALIGNMENT, &packAlignment);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, m_format == PixelFormat::RGBA ? GL_RGBA : GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+    glPixelStorei(GL_PACK_ALIGNMENT, packAlignment);
+    gl.bindBuffer(PIXEL_PACK_BUFFER, 0);
+
+    slot.fence = gl.fenceSync(SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.size = {width, height};
+    slot.index = m_nextIndex++;
+
+    m_nextSlot = (m_nextSlot + 1) % m_slots.size();
+    return true;
+}
+
+void AsyncReadback::collect()
+{
+    if(!m_valid)
+    {
+        return;
+    }
+    // The oldest read in flight is the one the next capture is going to reuse
+    for(size_t i = 0; i < m_slots.size(); ++i)
+    {
+        Slot& slot = m_slots[(m_nextSlot + i) % m_slots.size()];
+        if(slot.fence && !collectSlot(slot, false))
+        {
+            break;
+        }
+    }
+}
+
+void AsyncReadback::flush()
+{
+    if(!m_valid)
+    {
+        return;
+    }
+    for(size_t i = 0; i < m_slots.size(); ++i)
+    {
+        Slot& slot = m_slots[(m_nextSlot + i) % m_slots.size()];
+        if(slot.fence)
+        {
+            collectSlot(slot, true);
+        }
+    }
+}
+
+bool AsyncReadback::tryPopFrame(Frame& frame)
+{
+    if(m_queue.empty())
+    {
+        return false;
+    }
+    frame = std::move(m_queue.front());
+    m_queue.pop_front();
+    return true;
+}
+
+void AsyncReadback::recycle(Frame&& frame)
+{
+    if(frame.pixels.capacity() > 0)
+    {
+        m_pool.push_back(std::move(frame.pixels));
+    }
+}
+
+bool AsyncReadback::collectSlot(Slot& slot, bool wait)
+{
+    const unsigned int status = gl.clientWaitSync(slot.fence, SYNC_FLUSH_COMMANDS_BIT, wait ? WAIT_FOREVER : 0);
+    if(status != ALREADY_SIGNALED && status != CONDITION_SATISFIED)
+    {
+        return false;
+    }
+    gl.deleteSync(slot.fence);
+    slot.fence = nullptr;
+
+    const size_t size = static_cast<size_t>(slot.size.x) * static_cast<size_t>(slot.size.y) * bytesPerPixel(m_format);
+
+    Frame frame;
+    frame.size = slot.size;
+    frame.format = m_format;
+    frame.index = slot.index;
+    frame.pixels = acquireStorage(size);
+
+    gl.bindBuffer(PIXEL_PACK_BUFFER, slot.buffer);
+    const void* data = gl.mapBufferRange(PIXEL_PACK_BUFFER, 0, static_cast<ptrdiff_t>(size), MAP_READ_BIT);
+    if(data)
+    {
+        std::memcpy(frame.pixels.data(), data, size);
+        gl.unmapBuffer(PIXEL_PACK_BUFFER);
+    }
+    gl.bindBuffer(PIXEL_PACK_BUFFER, 0);
+
+    if(data)
+    {
+        deliver(std::move(frame));
+    }
+    else
+    {
+        recycle(std::move(frame));
+        ++m_droppedFrames;
+    }
+    return true;
+}
+
+void AsyncReadback::deliver(Frame&& frame)
+{
+    if(m_frameHandler)
+    {
+        std::invoke(m_frameHandler, frame);
+        recycle(std::move(frame));
+        return;
+    }
+    if(m_queue.size() >= m_slots.size())
+    {
+        recycle(std::move(m_queue.front()));
+        m_queue.pop_front();
+        ++m_droppedFrames;
+    }
+    m_queue.push_back(std::move(frame));
+}
+
+std::vector<unsigned char> AsyncReadback::acquireStorage(size_t size)
+{
+    std::vector<unsigned char> storage;
+    if(!m_pool.empty())
+    {
+        storage = std::move(m_pool.back());
+        m_pool.pop_back();
+    }
+    storage.resize(size);
+    return storage;
+}
+
+}
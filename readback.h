@@ -0,0 +1,120 @@
+#ifndef GLFWW_READBACK_H
+#define GLFWW_READBACK_H
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <vector>
+#include "window.h"
+
+namespace glfwW
+{
+
+/*!
+ * \brief A frame read back from a window's framebuffer
+ */
+struct Frame
+{
+    /*!
+     * \brief Size of the frame in pixels
+     */
+    Vec2<int> size;
+    PixelFormat format = PixelFormat::RGBA;
+    /*!
+     * \brief Sequential number of the capture the frame was produced by
+     */
+    uint64_t index = 0;
+    /*!
+     * \brief Tightly packed pixels, rows are stored bottom-up
+     */
+    std::vector<unsigned char> pixels;
+};
+
+/*!
+ * \brief Asynchronous framebuffer readback for a window.
+ * Reads are issued into a rotating set of pixel pack buffers guarded by fences, so the render thread never waits for the GPU.
+ * Completed frames are delivered one or two frames later either to a handler or to a queue.
+ * Pixel storage of delivered frames is reused from a pool.
+ * ! Requires OpenGL 3.2 (or ARB_sync). All methods have to be called with the window's context current.
+ */
+class AsyncReadback
+{
+public:
+    using FrameHandler = std::function<void(const Frame&)>;
+
+    explicit AsyncReadback(const Window& window, PixelFormat format = PixelFormat::RGBA, int bufferCount = 3);
+    AsyncReadback(const AsyncReadback&) = delete;
+    AsyncReadback& operator=(const AsyncReadback&) = delete;
+    ~AsyncReadback();
+
+    /*!
+     * \brief Returns false if the context doesn't provide pixel buffer objects or fences.
+     */
+    bool valid() const {return m_valid;}
+
+    /*!
+     * \brief Sets a handler for completed frames. The frame's storage is returned to the pool after the handler returns.
+     * If no handler is set, completed frames are queued and have to be taken with tryPopFrame().
+     */
+    void setFrameHandler(FrameHandler h);
+
+    /*!
+     * \brief Issues an asynchronous read of the current framebuffer and delivers frames whose transfers have completed.
+     * Call it before Window::swapBuffers(). Returns false if all buffers are still in flight and the capture was dropped.
+     */
+    bool capture();
+
+    /*!
+     * \brief Delivers completed frames without issuing a new read.
+     */
+    void collect();
+
+    /*!
+     * \brief Waits for all reads in flight and delivers them.
+     */
+    void flush();
+
+    /*!
+     * \brief Takes the oldest queued frame. Returns false if the queue is empty.
+     */
+    bool tryPopFrame(Frame& frame);
+
+    /*!
+     * \brief Returns the storage of a frame taken with tryPopFrame() to the pool.
+     */
+    void recycle(Frame&& frame);
+
+    /*!
+     * \brief Returns the number of captures dropped because all buffers were in flight or the queue was full.
+     */
+    uint64_t droppedFrames() const {return m_droppedFrames;}
+
+private:
+    struct Slot
+    {
+        unsigned int buffer = 0;
+        size_t capacity = 0;
+        void* fence = nullptr;
+        Vec2<int> size;
+        uint64_t index = 0;
+    };
+
+    bool collectSlot(Slot& slot, bool wait);
+    void deliver(Frame&& frame);
+    std::vector<unsigned char> acquireStorage(size_t size);
+
+    GLFWwindow* m_window = nullptr;
+    PixelFormat m_format = PixelFormat::RGBA;
+    bool m_valid = false;
+    std::vector<Slot> m_slots;
+    size_t m_nextSlot = 0;
+    uint64_t m_nextIndex = 0;
+    uint64_t m_droppedFrames = 0;
+    FrameHandler m_frameHandler;
+    std::deque<Frame> m_queue;
+    std::vector<std::vector<unsigned char>> m_pool;
+};
+
+}
+
+#endif
@@ -0,0 +1,215 @@
+#include "scheduler.h"
+#include <algorithm>
+#include "glfwlibrary.h"
+
+namespace glfwW
+{
+
+EventScheduler::EventScheduler():
+      m_mainThread(std::this_thread::get_id()),
+      m_frameInterval(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / 60.0)))
+{}
+
+EventScheduler::TimerId EventScheduler::addTimer(Clock::duration delay, TimerHandler handler, bool repeat)
+{
+    Timer timer;
+    timer.deadline = Clock::now() + delay;
+    timer.interval = std::max(delay, Clock::duration(1));
+    timer.handler = std::move(handler);
+    timer.repeat = repeat;
+
+    const TimerId id = ++m_lastTimerId;
+    m_timerQueue.push_back({timer.deadline, id});
+    std::push_heap(m_timerQueue.begin(), m_timerQueue.end(), std::greater<TimerEntry>());
+    m_timers.emplace(id, std::move(timer));
+    return id;
+}
+
+bool EventScheduler::cancelTimer(TimerId id)
+{
+    return m_timers.erase(id) != 0;
+}
+
+void EventScheduler::animate(const Window& window, Clock::time_point deadline)
+{
+    if(!window.valid())
+    {
+        return;
+    }
+    auto itr = m_animations.find(window.getHandler());
+    if(itr == m_animations.end())
+    {
+        m_animations.emplace(window.getHandler(), Animation{deadline, Clock::now()});
+    }
+    else
+    {
+        itr->second.deadline = std::max(itr->second.deadline, deadline);
+    }
+}
+
+void EventScheduler::stopAnimation(const Window& window)
+{
+    m_animations.erase(window.getHandler());
+}
+
+void EventScheduler::markDirty(const Window& window)
+{
+    if(!window.valid())
+    {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_dirtyMutex);
+        if(std::find(m_dirtyWindows.begin(), m_dirtyWindows.end(), window.getHandler()) == m_dirtyWindows.end())
+        {
+            m_dirtyWindows.push_back(window.getHandler());
+        }
+    }
+    m_hasDirtyWindows.store(true, std::memory_order_release);
+    if(!isMainThread())
+    {
+        glfwPostEmptyEvent();
+    }
+}
+
+void EventScheduler::wake()
+{
+    m_woken.store(true, std::memory_order_release);
+    glfwPostEmptyEvent();
+}
+
+void EventScheduler::runOnce()
+{
+    auto& library = GLFWlibrary::instance();
+    const bool pending = m_hasDirtyWindows.load(std::memory_order_acquire) || m_woken.exchange(false, std::memory_order_acq_rel);
+    const auto deadline = nextDeadline();
+    const auto now = Clock::now();
+
+    if(pending || deadline <= now)
+    {
+        library.pollEvents();
+    }
+    else if(deadline == Clock::time_point::max())
+    {
+        library.waitEvents();
+    }
+    else
+    {
+        library.waitEventsTimeout(std::chrono::duration<double>(deadline - now).count());
+    }
+
+    const auto wakeTime = Clock::now();
+    fireTimers(wakeTime);
+    advanceAnimations(wakeTime);
+    redrawDirtyWindows();
+}
+
+void EventScheduler::run()
+{
+    m_stopped.store(false, std::memory_order_release);
+    while(!m_stopped.load(std::memory_order_acquire))
+    {
+        runOnce();
+    }
+}
+
+void EventScheduler::stop()
+{
+    m_stopped.store(true, std::memory_order_release);
+    glfwPostEmptyEvent();
+}
+
+EventScheduler::Clock::time_point EventScheduler::nextDeadline() const
+{
+    auto result = Clock::time_point::max();
+    if(!m_timerQueue.empty())
+    {
+        // A stale entry only makes the loop wake up early, it never delays a timer
+        result = m_timerQueue.front().deadline;
+    }
+    for(const auto& animation : m_animations)
+    {
+        result = std::min(result, animation.second.nextFrame);
+    }
+    return result;
+}
+
+void EventScheduler::fireTimers(Clock::time_point now)
+{
+    while(!m_timerQueue.empty() && m_timerQueue.front().deadline <= now)
+    {
+        std::pop_heap(m_timerQueue.begin(), m_timerQueue.end(), std::greater<TimerEntry>());
+        const TimerEntry entry = m_timerQueue.back();
+        m_timerQueue.pop_back();
+
+        auto itr = m_timers.find(entry.id);
+        if(itr == m_timers.end() || itr->second.deadline != entry.deadline)
+        {
+            continue;
+        }
+
+        // The handler may add or cancel timers, so it is called on a copy
+        TimerHandler handler = itr->second.handler;
+        if(itr->second.repeat)
+        {
+            // Missed periods are skipped instead of firing in a burst
+            auto& timer = itr->second;
+            timer.deadline += timer.interval * ((now - timer.deadline) / timer.interval + 1);
+            m_timerQueue.push_back({timer.deadline, entry.id});
+            std::push_heap(m_timerQueue.begin(), m_timerQueue.end(), std::greater<TimerEntry>());
+        }
+        else
+        {
+            m_timers.erase(itr);
+        }
+
+        if(handler)
+        {
+            handler();
+        }
+    }
+}
+
+void EventScheduler::advanceAnimations(Clock::time_point now)
+{
+    for(auto itr = m_animations.begin(); itr != m_animations.end();)
+    {
+        auto& animation = itr->second;
+        if(animation.nextFrame <= now)
+        {
+            markDirty(Window(itr->first));
+            animation.nextFrame += m_frameInterval * ((now - animation.nextFrame) / m_frameInterval + 1);
+        }
+        if(now >= animation.deadline)
+        {
+            itr = m_animations.erase(itr);
+        }
+        else
+        {
+            ++itr;
+        }
+    }
+}
+
+void EventScheduler::redrawDirtyWindows()
+{
+    if(!m_hasDirtyWindows.load(std::memory_order_acquire))
+    {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_dirtyMutex);
+        m_redrawWindows.swap(m_dirtyWindows);
+        m_hasDirtyWindows.store(false, std::memory_order_release);
+    }
+    for(GLFWwindow* window : m_redrawWindows)
+    {
+        if(m_redrawHandler)
+        {
+            m_redrawHandler(Window(window));
+        }
+    }
+    m_redrawWindows.clear();
+}
+
+}
@@ -0,0 +1,144 @@
+#ifndef GLFWW_SCHEDULER_H
+#define GLFWW_SCHEDULER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "window.h"
+
+namespace glfwW
+{
+
+/*!
+ * \brief Runs the event loop in an event-driven way.
+ * Instead of polling at a fixed rate, the scheduler sleeps in waitEventsTimeout until the nearest of its wake-up sources:
+ * due timers, the next frame of a running animation or a window marked dirty.
+ * Without any of them the thread sleeps until an input event arrives.
+ * The scheduler has to be used on the main thread. markDirty() and wake() may be called from any thread.
+ * ! Animations and redraw requests refer to native windows, so stop them before destroying a window.
+ */
+class EventScheduler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimerId = uint64_t;
+    using TimerHandler = std::function<void()>;
+    using RedrawHandler = std::function<void(const Window&)>;
+
+    EventScheduler();
+    EventScheduler(const EventScheduler&) = delete;
+    EventScheduler& operator=(const EventScheduler&) = delete;
+
+    /*!
+     * \brief Sets the handler which redraws dirty windows. It is called once per dirty window after events are processed.
+     */
+    void setRedrawHandler(RedrawHandler handler) {m_redrawHandler = std::move(handler);}
+
+    /*!
+     * \brief Sets the interval between animation frames. Defaults to 1/60 s.
+     */
+    void setFrameInterval(Clock::duration interval) {m_frameInterval = interval;}
+
+    /*!
+     * \brief Calls the handler once after the delay, or every delay if repeat is set.
+     */
+    TimerId addTimer(Clock::duration delay, TimerHandler handler, bool repeat = false);
+
+    bool cancelTimer(TimerId id);
+
+    /*!
+     * \brief Redraws the window every frame interval until the deadline. A later deadline extends a running animation.
+     */
+    void animate(const Window& window, Clock::time_point deadline);
+
+    void animateFor(const Window& window, Clock::duration duration)
+    {
+        animate(window, Clock::now() + duration);
+    }
+
+    void stopAnimation(const Window& window);
+
+    /*!
+     * \brief Requests a redraw of the window. May be called from any thread.
+     */
+    void markDirty(const Window& window);
+
+    /*!
+     * \brief Wakes up the sleeping event loop. May be called from any thread.
+     */
+    void wake();
+
+    /*!
+     * \brief Waits for the nearest wake-up source, processes events, fires due timers and redraws dirty windows.
+     */
+    void runOnce();
+
+    /*!
+     * \brief Calls runOnce() until stop() is called.
+     */
+    void run();
+
+    /*!
+     * \brief Makes run() return after the current iteration. May be called from any thread.
+     */
+    void stop();
+
+private:
+    struct Timer
+    {
+        Clock::time_point deadline;
+        Clock::duration interval;
+        TimerHandler handler;
+        bool repeat = false;
+    };
+
+    struct TimerEntry
+    {
+        Clock::time_point deadline;
+        TimerId id = 0;
+
+        bool operator>(const TimerEntry& other) const {return deadline > other.deadline;}
+    };
+
+    struct Animation
+    {
+        Clock::time_point deadline;
+        Clock::time_point nextFrame;
+    };
+
+    /*!
+     * \brief Returns the nearest deadline, or time_point::max() if there is none.
+     */
+    Clock::time_point nextDeadline() const;
+    void fireTimers(Clock::time_point now);
+    void advanceAnimations(Clock::time_point now);
+    void redrawDirtyWindows();
+    bool isMainThread() const {return std::this_thread::get_id() == m_mainThread;}
+
+    std::thread::id m_mainThread;
+    Clock::duration m_frameInterval;
+    RedrawHandler m_redrawHandler;
+
+    // Min-heap of timer deadlines. Entries of cancelled or rescheduled timers are skipped when they come up.
+    std::vector<TimerEntry> m_timerQueue;
+    std::unordered_map<TimerId, Timer> m_timers;
+    TimerId m_lastTimerId = 0;
+
+    std::unordered_map<GLFWwindow*, Animation> m_animations;
+
+    std::mutex m_dirtyMutex;
+    std::vector<GLFWwindow*> m_dirtyWindows;
+    std::vector<GLFWwindow*> m_redrawWindows;
+    std::atomic<bool> m_hasDirtyWindows{false};
+    std::atomic<bool> m_woken{false};
+    std::atomic<bool> m_stopped{false};
+};
+
+}
+
+#endif
@@ -0,0 +1,457 @@
+#include "shortcuts.h"
+#include <algorithm>
+#include "utils.h"
+
+namespace glfwW
+{
+
+namespace
+{
+
+struct KeyName
+{
+    const char* name;
+    Key key;
+};
+
+const KeyName KEY_NAMES[] = {
+    {"Space", Key::KEY_SPACE},
+    {"Apostrophe", Key::KEY_APOSTROPHE},
+    {"Comma", Key::KEY_COMMA},
+    {"Minus", Key::KEY_MINUS},
+    {"Period", Key::KEY_PERIOD},
+    {"Slash", Key::KEY_SLASH},
+    {"0", Key::KEY_0},
+    {"1", Key::KEY_1},
+    {"2", Key::KEY_2},
+    {"3", Key::KEY_3},
+    {"4", Key::KEY_4},
+    {"5", Key::KEY_5},
+    {"6", Key::KEY_6},
+    {"7", Key::KEY_7},
+    {"8", Key::KEY_8},
+    {"9", Key::KEY_9},
+    {"Semicolon", Key::KEY_SEMICOLON},
+    {"Equal", Key::KEY_EQUAL},
+    {"A", Key::KEY_A},
+    {"B", Key::KEY_B},
+    {"C", Key::KEY_C},
+    {"D", Key::KEY_D},
+    {"E", Key::KEY_E},
+    {"F", Key::KEY_F},
+    {"G", Key::KEY_G},
+    {"H", Key::KEY_H},
+    {"I", Key::KEY_I},
+    {"J", Key::KEY_J},
+    {"K", Key::KEY_K},
+    {"L", Key::KEY_L},
+    {"M", Key::KEY_M},
+    {"N", Key::KEY_N},
+    {"O", Key::KEY_O},
+    {"P", Key::KEY_P},
+    {"Q", Key::KEY_Q},
+    {"R", Key::KEY_R},
+    {"S", Key::KEY_S},
+    {"T", Key::KEY_T},
+    {"U", Key::KEY_U},
+    {"V", Key::KEY_V},
+    {"W", Key::KEY_W},
+    {"X", Key::KEY_X},
+    {"Y", Key::KEY_Y},
+    {"Z", Key::KEY_Z},
+    {"LeftBracket", Key::KEY_LEFT_BRACKET},
+    {"Backslash", Key::KEY_BACKSLASH},
+    {"RightBracket", Key::KEY_RIGHT_BRACKET},
+    {"GraveAccent", Key::KEY_GRAVE_ACCENT},
+    {"World1", Key::KEY_WORLD_1},
+    {"World2", Key::KEY_WORLD_2},
+    {"Escape", Key::KEY_ESCAPE},
+    {"Enter", Key::KEY_ENTER},
+    {"Tab", Key::KEY_TAB},
+    {"Backspace", Key::KEY_BACKSPACE},
+    {"Insert", Key::KEY_INSERT},
+    {"Delete", Key::KEY_DELETE},
+    {"Right", Key::KEY_RIGHT},
+    {"Left", Key::KEY_LEFT},
+    {"Down", Key::KEY_DOWN},
+    {"Up", Key::KEY_UP},
+    {"PageUp", Key::KEY_PAGE_UP},
+    {"PageDown", Key::KEY_PAGE_DOWN},
+    {"Home", Key::KEY_HOME},
+    {"End", Key::KEY_END},
+    {"CapsLock", Key::KEY_CAPS_LOCK},
+    {"ScrollLock", Key::KEY_SCROLL_LOCK},
+    {"NumLock", Key::KEY_NUM_LOCK},
+    {"PrintScreen", Key::KEY_PRINT_SCREEN},
+    {"Pause", Key::KEY_PAUSE},
+    {"F1", Key::KEY_F1},
+    {"F2", Key::KEY_F2},
+    {"F3", Key::KEY_F3},
+    {"F4", Key::KEY_F4},
+    {"F5", Key::KEY_F5},
+    {"F6", Key::KEY_F6},
+    {"F7", Key::KEY_F7},
+    {"F8", Key::KEY_F8},
+    {"F9", Key::KEY_F9},
+    {"F10", Key::KEY_F10},
+    {"F11", Key::KEY_F11},
+    {"F12", Key::KEY_F12},
+    {"F13", Key::KEY_F13},
+    {"F14", Key::KEY_F14},
+    {"F15", Key::KEY_F15},
+    {"F16", Key::KEY_F16},
+    {"F17", Key::KEY_F17},
+    {"F18", Key::KEY_F18},
+    {"F19", Key::KEY_F19},
+    {"F20", Key::KEY_F20},
+    {"F21", Key::KEY_F21},
+    {"F22", Key::KEY_F22},
+    {"F23", Key::KEY_F23},
+    {"F24", Key::KEY_F24},
+    {"F25", Key::KEY_F25},
+    {"Kp0", Key::KEY_KP_0},
+    {"Kp1", Key::KEY_KP_1},
+    {"Kp2", Key::KEY_KP_2},
+    {"Kp3", Key::KEY_KP_3},
+    {"Kp4", Key::KEY_KP_4},
+    {"Kp5", Key::KEY_KP_5},
+    {"Kp6", Key::KEY_KP_6},
+    {"Kp7", Key::KEY_KP_7},
+    {"Kp8", Key::KEY_KP_8},
+    {"Kp9", Key::KEY_KP_9},
+    {"KpDecimal", Key::KEY_KP_DECIMAL},
+    {"KpDivide", Key::KEY_KP_DIVIDE},
+    {"KpMultiply", Key::KEY_KP_MULTIPLY},
+    {"KpSubtract", Key::KEY_KP_SUBTRACT},
+    {"KpAdd", Key::KEY_KP_ADD},
+    {"KpEnter", Key::KEY_KP_ENTER},
+    {"KpEqual", Key::KEY_KP_EQUAL},
+    {"LeftShift", Key::KEY_LEFT_SHIFT},
+    {"LeftControl", Key::KEY_LEFT_CONTROL},
+    {"LeftAlt", Key::KEY_LEFT_ALT},
+    {"LeftSuper", Key::KEY_LEFT_SUPER},
+    {"RightShift", Key::KEY_RIGHT_SHIFT},
+    {"RightControl", Key::KEY_RIGHT_CONTROL},
+    {"RightAlt", Key::KEY_RIGHT_ALT},
+    {"RightSuper", Key::KEY_RIGHT_SUPER},
+    {"Menu", Key::KEY_MENU},
+    {"Esc", Key::KEY_ESCAPE},
+    {"Return", Key::KEY_ENTER},
+    {"Del", Key::KEY_DELETE},
+    {"Ins", Key::KEY_INSERT},
+    {"PgUp", Key::KEY_PAGE_UP},
+    {"PgDn", Key::KEY_PAGE_DOWN},
+    {"'", Key::KEY_APOSTROPHE},
+    {"-", Key::KEY_MINUS},
+    {".", Key::KEY_PERIOD},
+    {"/", Key::KEY_SLASH},
+    {";", Key::KEY_SEMICOLON},
+    {"=", Key::KEY_EQUAL},
+    {"[", Key::KEY_LEFT_BRACKET},
+    {"\\", Key::KEY_BACKSLASH},
+    {"]", Key::KEY_RIGHT_BRACKET},
+    {"`", Key::KEY_GRAVE_ACCENT},
+};
+
+struct ModifierName
+{
+    const char* name;
+    KeyModifier modifier;
+};
+
+const ModifierName MODIFIER_NAMES[] = {
+    {"ctrl", CONTROL},
+    {"control", CONTROL},
+    {"shift", SHIFT},
+    {"alt", ALT},
+    {"option", ALT},
+    {"super", SUPER},
+    {"cmd", SUPER},
+    {"meta", SUPER},
+    {"win", SUPER},
+};
+
+bool isModifierKey(Key key)
+{
+    return key >= Key::KEY_LEFT_SHIFT && key <= Key::KEY_RIGHT_SUPER;
+}
+
+}
+
+bool parseKey(const std::string& name, Key& key)
+{
+    const std::string text = trim(name);
+    if(text.empty())
+    {
+        return false;
+    }
+    for(const auto& entry : KEY_NAMES)
+    {
+        if(equalNames(text, entry.name))
+        {
+            key = entry.key;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseKeyChord(const std::string& text, KeyChord& chord)
+{
+    KeyChord result;
+    bool hasKey = false;
+    size_t begin = 0;
+    while(begin <= text.size())
+    {
+        auto end = text.find('+', begin);
+        if(end == std::string::npos)
+        {
+            end = text.size();
+        }
+        const std::string token = trim(text.substr(begin, end - begin));
+        begin = end + 1;
+
+        // The key goes last, after the modifiers
+        if(token.empty() || hasKey)
+        {
+            return false;
+        }
+        auto modifier = std::find_if(std::begin(MODIFIER_NAMES), std::end(MODIFIER_NAMES), [&token](const ModifierName& entry){
+            return equalNames(token, entry.name);
+        });
+        if(modifier != std::end(MODIFIER_NAMES))
+        {
+            result.modifiers |= modifier->modifier;
+        }
+        else if(parseKey(token, result.key))
+        {
+            hasKey = true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    if(!hasKey)
+    {
+        return false;
+    }
+    chord = result;
+    return true;
+}
+
+bool parseKeySequence(const std::string& text, std::vector<KeyChord>& sequence)
+{
+    std::vector<KeyChord> result;
+    size_t begin = 0;
+    while(begin <= text.size())
+    {
+        auto end = text.find(',', begin);
+        if(end == std::string::npos)
+        {
+            end = text.size();
+        }
+        KeyChord chord;
+        if(!parseKeyChord(text.substr(begin, end - begin), chord))
+        {
+            return false;
+        }
+        result.push_back(chord);
+        begin = end + 1;
+    }
+    sequence = std::move(result);
+    return true;
+}
+
+bool ShortcutEngine::bind(const std::string& sequence, Handler handler)
+{
+    std::vector<KeyChord> chords;
+    return parseKeySequence(sequence, chords) && bind(chords, std::move(handler));
+}
+
+bool ShortcutEngine::bind(const std::vector<KeyChord>& sequence, Handler handler)
+{
+    auto chords = encode(sequence);
+    if(chords.empty() || !handler)
+    {
+        return false;
+    }
+
+    auto itr = std::find_if(m_bindings.begin(), m_bindings.end(), [&chords](const Binding& binding){
+        return binding.chords == chords;
+    });
+    if(itr != m_bindings.end())
+    {
+        itr->handler = std::move(handler);
+        return true;
+    }
+
+    Binding binding;
+    binding.chords = std::move(chords);
+    binding.handler = std::move(handler);
+    m_bindings.push_back(std::move(binding));
+    m_compiled = false;
+    reset();
+    return true;
+}
+
+bool ShortcutEngine::unbind(const std::string& sequence)
+{
+    std::vector<KeyChord> chords;
+    return parseKeySequence(sequence, chords) && unbind(chords);
+}
+
+bool ShortcutEngine::unbind(const std::vector<KeyChord>& sequence)
+{
+    const auto chords = encode(sequence);
+    auto itr = std::find_if(m_bindings.begin(), m_bindings.end(), [&chords](const Binding& binding){
+        return binding.chords == chords;
+    });
+    if(chords.empty() || itr == m_bindings.end())
+    {
+        return false;
+    }
+    m_bindings.erase(itr);
+    m_compiled = false;
+    reset();
+    return true;
+}
+
+void ShortcutEngine::clear()
+{
+    m_bindings.clear();
+    m_compiled = false;
+    reset();
+}
+
+bool ShortcutEngine::dispatch(const Window& window, const KeyEvent& event)
+{
+    return dispatch(window, event, glfwGetTime());
+}
+
+bool ShortcutEngine::dispatch(const Window& window, const KeyEvent& event, double time)
+{
+    if(!window.valid() || event.action != Action::PRESS || event.key == Key::KEY_UNKNOWN || event.key >= Key::KEY_LAST || isModifierKey(event.key))
+    {
+        return false;
+    }
+
+    if(!m_compiled)
+    {
+        compile();
+    }
+    bool handled = update(time);
+
+    KeyChord chord;
+    chord.key = event.key;
+    chord.modifiers = event.modifiers();
+    const uint32_t code = chordCode(chord);
+    if(advance(code, time, window.getHandler()))
+    {
+        return true;
+    }
+    if(pending())
+    {
+        // The chord doesn't continue the sequence: finish it and try the chord as the start of a new one
+        handled = finishPending() || handled;
+        handled = advance(code, time, window.getHandler()) || handled;
+    }
+    return handled;
+}
+
+bool ShortcutEngine::update(double time)
+{
+    if(!pending() || time < m_deadline)
+    {
+        return false;
+    }
+    return finishPending();
+}
+
+void ShortcutEngine::reset()
+{
+    m_state = ROOT;
+    m_deadline = 0.0;
+}
+
+uint32_t ShortcutEngine::chordCode(const KeyChord& chord)
+{
+    return static_cast<uint32_t>(chord.key) << 4 | static_cast<uint32_t>(chord.modifiers.withoutLocks().toGlfwBits());
+}
+
+std::vector<uint32_t> ShortcutEngine::encode(const std::vector<KeyChord>& sequence) const
+{
+    std::vector<uint32_t> chords;
+    chords.reserve(sequence.size());
+    for(const auto& chord : sequence)
+    {
+        if(chord.key == Key::KEY_UNKNOWN || chord.key >= Key::KEY_LAST || isModifierKey(chord.key))
+        {
+            return std::vector<uint32_t>();
+        }
+        chords.push_back(chordCode(chord));
+    }
+    return chords;
+}
+
+void ShortcutEngine::compile()
+{
+    m_nodes.assign(1, Node());
+    m_transitions.clear();
+    m_transitions.reserve(m_bindings.size() * 2);
+    for(size_t i = 0; i < m_bindings.size(); ++i)
+    {
+        uint32_t state = ROOT;
+        for(const auto chord : m_bindings[i].chords)
+        {
+            auto result = m_transitions.emplace(transitionKey(state, chord), static_cast<uint32_t>(m_nodes.size()));
+            if(result.second)
+            {
+                m_nodes[state].hasChildren = true;
+                m_nodes.emplace_back();
+            }
+            state = result.first->second;
+        }
+        m_nodes[state].binding = static_cast<int>(i);
+    }
+    m_compiled = true;
+}
+
+bool ShortcutEngine::advance(uint32_t chord, double time, GLFWwindow* window)
+{
+    auto itr = m_transitions.find(transitionKey(m_state, chord));
+    if(itr == m_transitions.end())
+    {
+        return false;
+    }
+
+    const Node& node = m_nodes[itr->second];
+    if(node.hasChildren)
+    {
+        m_state = itr->second;
+        m_deadline = time + m_timeout;
+        m_window = window;
+        return true;
+    }
+
+    // A copy, because the handler may change the bindings
+    const Handler handler = m_bindings[node.binding].handler;
+    reset();
+    handler(Window(window));
+    return true;
+}
+
+bool ShortcutEngine::finishPending()
+{
+    const int binding = m_nodes[m_state].binding;
+    reset();
+    if(binding < 0 || !m_window)
+    {
+        return false;
+    }
+    const Handler handler = m_bindings[binding].handler;
+    handler(Window(m_window));
+    return true;
+}
+
+}
@@ -0,0 +1,139 @@
+#ifndef GLFWW_SHORTCUTS_H
+#define GLFWW_SHORTCUTS_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "events.h"
+#include "window.h"
+
+namespace glfwW
+{
+
+/*!
+ * \brief A key with the SHIFT, CONTROL, ALT and SUPER modifiers pressed with it
+ */
+struct KeyChord
+{
+    Key key = Key::KEY_UNKNOWN;
+    ModifierSet modifiers;
+};
+
+/*!
+ * \brief Parses a key name, e.g. "A", "F5", "PageUp", "Escape" or "KpAdd". Names are case-insensitive.
+ */
+bool parseKey(const std::string& name, Key& key);
+
+/*!
+ * \brief Parses a chord, e.g. "Ctrl+Shift+S". Modifiers are Ctrl (Control), Shift, Alt (Option) and Super (Cmd, Meta, Win).
+ */
+bool parseKeyChord(const std::string& text, KeyChord& chord);
+
+/*!
+ * \brief Parses a comma-separated sequence of chords, e.g. "Ctrl+K, Ctrl+S".
+ */
+bool parseKeySequence(const std::string& text, std::vector<KeyChord>& sequence);
+
+/*!
+ * \brief Resolves key events to shortcuts made of one or more chords, e.g. "Shift+F5" or "Ctrl+K, Ctrl+S".
+ * Bindings are compiled into a trie whose transitions are kept in a single hash table keyed by (state, chord),
+ * so each key event costs one lookup however many bindings there are.
+ * A sequence is abandoned if its next chord doesn't come within the timeout. When a binding is also the prefix
+ * of a longer one, it fires once the timeout expires or a chord that doesn't continue the longer binding is pressed.
+ * Times are in seconds of glfwGetTime(). The engine has to be used on the main thread.
+ */
+class ShortcutEngine
+{
+public:
+    using Handler = std::function<void(const Window&)>;
+
+    static constexpr double DEFAULT_TIMEOUT = 1.0;
+
+    /*!
+     * \brief Binds the handler to the sequence, replacing the previous binding.
+     * Returns false if the sequence can't be parsed or the handler is empty.
+     */
+    bool bind(const std::string& sequence, Handler handler);
+    bool bind(const std::vector<KeyChord>& sequence, Handler handler);
+
+    bool unbind(const std::string& sequence);
+    bool unbind(const std::vector<KeyChord>& sequence);
+
+    void clear();
+
+    size_t size() const {return m_bindings.size();}
+
+    void setTimeout(double seconds) {m_timeout = seconds;}
+
+    double timeout() const {return m_timeout;}
+
+    /*!
+     * \brief Feeds a key event. Returns true if the event was consumed by a binding or a sequence in progress.
+     * Releases, repeats and presses of modifier keys are ignored.
+     * A binding completed by a timeout is called with the window of the last chord, so reset() the engine
+     * before destroying that window.
+     */
+    bool dispatch(const Window& window, const KeyEvent& event);
+    bool dispatch(const Window& window, const KeyEvent& event, double time);
+
+    /*!
+     * \brief Returns true if a sequence is in progress.
+     */
+    bool pending() const {return m_state != ROOT;}
+
+    /*!
+     * \brief Returns the time the sequence in progress expires at, e.g. for an EventScheduler timer.
+     * Returns a negative value if no sequence is in progress.
+     */
+    double deadline() const {return pending() ? m_deadline : -1.0;}
+
+    /*!
+     * \brief Abandons the sequence in progress if it has expired at the given time, and calls the binding it completes.
+     * Returns true if a handler was called.
+     */
+    bool update(double time);
+
+    /*!
+     * \brief Abandons the sequence in progress without calling its binding.
+     */
+    void reset();
+
+private:
+    struct Binding
+    {
+        std::vector<uint32_t> chords;
+        Handler handler;
+    };
+
+    struct Node
+    {
+        int binding = -1;
+        bool hasChildren = false;
+    };
+
+    static constexpr uint32_t ROOT = 0;
+
+    static uint32_t chordCode(const KeyChord& chord);
+    static uint64_t transitionKey(uint32_t state, uint32_t chord) {return (static_cast<uint64_t>(state) << 32) | chord;}
+
+    std::vector<uint32_t> encode(const std::vector<KeyChord>& sequence) const;
+    void compile();
+    bool advance(uint32_t chord, double time, GLFWwindow* window);
+    bool finishPending();
+
+    std::vector<Binding> m_bindings;
+    std::vector<Node> m_nodes;
+    std::unordered_map<uint64_t, uint32_t> m_transitions;
+    bool m_compiled = false;
+
+    uint32_t m_state = ROOT;
+    double m_deadline = 0.0;
+    GLFWwindow* m_window = nullptr;
+    double m_timeout = DEFAULT_TIMEOUT;
+};
+
+}
+
+#endif
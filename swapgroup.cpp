@@ -0,0 +1,132 @@
+#include "swapgroup.h"
+#include <algorithm>
+
+namespace glfwW
+{
+
+namespace
+{
+
+// Weight of the newest sample in the moving averages
+constexpr double AVERAGE_WEIGHT = 0.1;
+
+double movingAverage(double average, double sample, uint64_t count)
+{
+    return count <= 1 ? sample : average + (sample - average) * AVERAGE_WEIGHT;
+}
+
+}
+
+void SwapGroup::add(const Window& window)
+{
+    if(!window.valid() || std::any_of(m_members.begin(), m_members.end(), [&window](const Member& member){
+           return member.window == window.getHandler();
+       }))
+    {
+        return;
+    }
+    Member member;
+    member.window = window.getHandler();
+    m_members.push_back(member);
+}
+
+bool SwapGroup::remove(const Window& window)
+{
+    auto itr = std::find_if(m_members.begin(), m_members.end(), [&window](const Member& member){
+        return member.window == window.getHandler();
+    });
+    if(itr == m_members.end())
+    {
+        return false;
+    }
+    m_members.erase(itr);
+    return true;
+}
+
+void SwapGroup::present(const RenderHandler& render)
+{
+    if(m_members.empty())
+    {
+        return;
+    }
+
+    const size_t last = m_members.size() - 1;
+    // Every window but the synchronized one can go in any order, so start with the one whose context is current
+    GLFWwindow* current = currentContext();
+    size_t first = 0;
+    for(size_t i = 0; i < last; ++i)
+    {
+        if(m_members[i].window == current)
+        {
+            first = i;
+            break;
+        }
+    }
+
+    for(size_t i = 0; i < last; ++i)
+    {
+        presentMember(m_members[(first + i) % last], 0, render);
+    }
+    presentMember(m_members[last], m_vsync ? 1 : 0, render);
+}
+
+SwapStatistics SwapGroup::statistics(const Window& window) const
+{
+    auto itr = std::find_if(m_members.begin(), m_members.end(), [&window](const Member& member){
+        return member.window == window.getHandler();
+    });
+    return itr != m_members.end() ? itr->statistics : SwapStatistics();
+}
+
+void SwapGroup::resetStatistics()
+{
+    for(auto& member : m_members)
+    {
+        member.statistics = SwapStatistics();
+        member.lastSwapEnd = 0.0;
+    }
+    m_contextSwitches = 0;
+}
+
+void SwapGroup::makeCurrent(GLFWwindow* window)
+{
+    if(makeContextCurrent(window))
+    {
+        ++m_contextSwitches;
+    }
+}
+
+void SwapGroup::presentMember(Member& member, int swapInterval, const RenderHandler& render)
+{
+    makeCurrent(member.window);
+    // The swap interval is state of the current context, so it is only set when it changes
+    if(member.swapInterval != swapInterval)
+    {
+        glfwSwapInterval(swapInterval);
+        member.swapInterval = swapInterval;
+    }
+
+    if(render)
+    {
+        render(Window(member.window));
+    }
+
+    const double swapBegin = glfwGetTime();
+    Window(member.window).swapBuffers();
+    const double swapEnd = glfwGetTime();
+
+    auto& statistics = member.statistics;
+    ++statistics.frameCount;
+    statistics.lastSwapDuration = swapEnd - swapBegin;
+    statistics.averageSwapDuration = movingAverage(statistics.averageSwapDuration, statistics.lastSwapDuration, statistics.frameCount);
+    statistics.maxSwapDuration = std::max(statistics.maxSwapDuration, statistics.lastSwapDuration);
+    if(member.lastSwapEnd > 0.0)
+    {
+        statistics.lastFrameInterval = swapEnd - member.lastSwapEnd;
+        statistics.averageFrameInterval = movingAverage(statistics.averageFrameInterval, statistics.lastFrameInterval,
+                                                        statistics.frameCount - 1);
+    }
+    member.lastSwapEnd = swapEnd;
+}
+
+}
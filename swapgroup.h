@@ -0,0 +1,103 @@
+#ifndef GLFWW_SWAPGROUP_H
+#define GLFWW_SWAPGROUP_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "window.h"
+
+namespace glfwW
+{
+
+/*!
+ * \brief Swap timings of a window in a SwapGroup (in seconds)
+ */
+struct SwapStatistics
+{
+    uint64_t frameCount = 0;
+    /*!
+     * \brief Time spent in the last glfwSwapBuffers call
+     */
+    double lastSwapDuration = 0.0;
+    /*!
+     * \brief Exponential moving average of the swap duration
+     */
+    double averageSwapDuration = 0.0;
+    double maxSwapDuration = 0.0;
+    /*!
+     * \brief Time between the last two swaps
+     */
+    double lastFrameInterval = 0.0;
+    /*!
+     * \brief Exponential moving average of the frame interval
+     */
+    double averageFrameInterval = 0.0;
+};
+
+/*!
+ * \brief Renders and presents several windows per frame so that the frame is synchronized to the display only once.
+ * With vsync every window waits for a refresh in glfwSwapBuffers, so N windows would run at 1/N of the refresh rate.
+ * The group enables vsync only for the window presented last and disables it for the others.
+ * Each window is rendered and swapped in a single visit, and the window whose context is current goes first,
+ * so a frame needs at most one context switch per window.
+ * The group doesn't own its windows. It has to be used on the thread the contexts are made current on.
+ */
+class SwapGroup
+{
+public:
+    using RenderHandler = std::function<void(const Window&)>;
+
+    /*!
+     * \brief Adds a window. Windows are presented in the order they are added, the last one is synchronized.
+     */
+    void add(const Window& window);
+
+    bool remove(const Window& window);
+
+    size_t size() const {return m_members.size();}
+
+    /*!
+     * \brief Enables synchronization of the last window to the display refresh. Enabled by default.
+     */
+    void setVsync(bool enabled) {m_vsync = enabled;}
+
+    bool vsync() const {return m_vsync;}
+
+    /*!
+     * \brief Renders and swaps all windows. The handler is called with the window's context current.
+     */
+    void present(const RenderHandler& render);
+
+    /*!
+     * \brief Returns swap timings of the window, or empty statistics if it isn't in the group.
+     */
+    SwapStatistics statistics(const Window& window) const;
+
+    /*!
+     * \brief Returns the number of glfwMakeContextCurrent calls made by the group.
+     */
+    uint64_t contextSwitches() const {return m_contextSwitches;}
+
+    void resetStatistics();
+
+private:
+    struct Member
+    {
+        GLFWwindow* window = nullptr;
+        // The swap interval last set for the window's context, -1 if unknown
+        int swapInterval = -1;
+        double lastSwapEnd = 0.0;
+        SwapStatistics statistics;
+    };
+
+    void makeCurrent(GLFWwindow* window);
+    void presentMember(Member& member, int swapInterval, const RenderHandler& render);
+
+    std::vector<Member> m_members;
+    bool m_vsync = true;
+    uint64_t m_contextSwitches = 0;
+};
+
+}
+
+#endif
@@ -0,0 +1,66 @@
+#include "task.h"
+
+namespace glfwW
+{
+
+TaskQueue::TaskQueue(size_t capacity)
+{
+    size_t size = 2;
+    while(size < capacity)
+    {
+        size *= 2;
+    }
+    m_cells.reset(new Cell[size]);
+    m_mask = size - 1;
+    for(size_t i = 0; i < size; ++i)
+    {
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool TaskQueue::push(Task&& task)
+{
+    // A cell is free for position p when its sequence is p, and holds a task for position p when it is p + 1
+    Cell* cell = nullptr;
+    size_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+    while(true)
+    {
+        cell = &m_cells[position & m_mask];
+        const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+        if(difference == 0)
+        {
+            if(m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if(difference < 0)
+        {
+            return false;
+        }
+        else
+        {
+            position = m_enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->task = std::move(task);
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+bool TaskQueue::pop(Task& task)
+{
+    Cell& cell = m_cells[m_dequeuePosition & m_mask];
+    if(cell.sequence.load(std::memory_order_acquire) != m_dequeuePosition + 1)
+    {
+        return false;
+    }
+    task = std::move(cell.task);
+    cell.sequence.store(m_dequeuePosition + m_mask + 1, std::memory_order_release);
+    ++m_dequeuePosition;
+    return true;
+}
+
+}
@@ -0,0 +1,176 @@
+#ifndef GLFWW_TASK_H
+#define GLFWW_TASK_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace glfwW
+{
+
+/*!
+ * \brief A move-only void() callable. Callables of up to INLINE_SIZE bytes are stored inline, larger ones on the heap.
+ */
+class Task
+{
+public:
+    static constexpr size_t INLINE_SIZE = 48;
+
+    Task() = default;
+
+    template<typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Task> &&
+                                                     std::is_invocable_r_v<void, std::decay_t<F>&>>>
+    Task(F&& function)
+    {
+        using Function = std::decay_t<F>;
+        if constexpr(fitsInline<Function>())
+        {
+            new (&m_storage) Function(std::forward<F>(function));
+            m_operations = &inlineOperations<Function>;
+        }
+        else
+        {
+            new (&m_storage) Function*(new Function(std::forward<F>(function)));
+            m_operations = &heapOperations<Function>;
+        }
+    }
+
+    Task(Task&& rhs) noexcept
+    {
+        moveFrom(rhs);
+    }
+
+    Task& operator=(Task&& rhs) noexcept
+    {
+        if(this != &rhs)
+        {
+            reset();
+            moveFrom(rhs);
+        }
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task()
+    {
+        reset();
+    }
+
+    explicit operator bool() const {return m_operations != nullptr;}
+
+    void operator()()
+    {
+        m_operations->invoke(&m_storage);
+    }
+
+    void reset()
+    {
+        if(m_operations)
+        {
+            m_operations->destroy(&m_storage);
+            m_operations = nullptr;
+        }
+    }
+
+private:
+    struct Operations
+    {
+        void(* invoke)(void*);
+        // Move-constructs into the first storage and destroys the second
+        void(* relocate)(void*, void*);
+        void(* destroy)(void*);
+    };
+
+    using Storage = std::aligned_storage_t<INLINE_SIZE, alignof(std::max_align_t)>;
+
+    template<typename F>
+    static constexpr bool fitsInline()
+    {
+        return sizeof(F) <= INLINE_SIZE && alignof(std::max_align_t) % alignof(F) == 0 &&
+               std::is_nothrow_move_constructible_v<F>;
+    }
+
+    template<typename F>
+    static constexpr Operations inlineOperations = {
+        [](void* storage){(*static_cast<F*>(storage))();},
+        [](void* destination, void* source){
+            new (destination) F(std::move(*static_cast<F*>(source)));
+            static_cast<F*>(source)->~F();
+        },
+        [](void* storage){static_cast<F*>(storage)->~F();}
+    };
+
+    template<typename F>
+    static constexpr Operations heapOperations = {
+        [](void* storage){(**static_cast<F**>(storage))();},
+        [](void* destination, void* source){new (destination) F*(*static_cast<F**>(source));},
+        [](void* storage){delete *static_cast<F**>(storage);}
+    };
+
+    void moveFrom(Task& rhs)
+    {
+        if(rhs.m_operations)
+        {
+            rhs.m_operations->relocate(&m_storage, &rhs.m_storage);
+            m_operations = rhs.m_operations;
+            rhs.m_operations = nullptr;
+        }
+    }
+
+    Storage m_storage;
+    const Operations* m_operations = nullptr;
+};
+
+/*!
+ * \brief A bounded, lock-free queue of tasks with any number of producers and a single consumer.
+ * Tasks are stored in a preallocated ring, so posting a small task doesn't allocate.
+ */
+class TaskQueue
+{
+public:
+    /*!
+     * \brief The capacity is rounded up to a power of two.
+     */
+    explicit TaskQueue(size_t capacity = 1024);
+    TaskQueue(const TaskQueue&) = delete;
+    TaskQueue& operator=(const TaskQueue&) = delete;
+
+    /*!
+     * \brief Adds a task. May be called from any thread. Returns false if the queue is full.
+     */
+    bool push(Task&& task);
+
+    /*!
+     * \brief Takes the oldest task. Has to be called from one thread only. Returns false if the queue is empty.
+     */
+    bool pop(Task& task);
+
+    /*!
+     * \brief Returns the number of tasks pushed and not taken yet, including pushes still in progress.
+     * Has to be called from the thread calling pop().
+     */
+    size_t size() const {return m_enqueuePosition.load(std::memory_order_acquire) - m_dequeuePosition;}
+
+    size_t capacity() const {return m_mask + 1;}
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence{0};
+        Task task;
+    };
+
+    std::unique_ptr<Cell[]> m_cells;
+    size_t m_mask = 0;
+    alignas(64) std::atomic<size_t> m_enqueuePosition{0};
+    alignas(64) size_t m_dequeuePosition = 0;
+};
+
+}
+
+#endif
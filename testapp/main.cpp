@@ -27,7 +27,9 @@ std::filesystem::path getPath(const char* dir, const char* file)
 int main()
 {
     glfwW::GLFWlibrary &lib = glfwW::GLFWlibrary::instance();
-    const auto error = lib.init();
+    glfwW::GLFWlibrary::InitHints initHints;
+    initHints.monitorWarmUp = glfwW::MonitorWarmUp::DEFERRED;
+    const auto error = lib.init(initHints);
 
     if (error.code != glfwW::ErrorCode::NO_ERROR) {
         std::cout << error.description;
@@ -66,8 +68,8 @@ int main()
         }
     });
 
-    window.setTextHandler([](const glfwW::Window&, unsigned int codepoint){
-        std::cerr << (char)codepoint << "\n";
+    window.setTextBatchHandler([](const glfwW::Window&, std::string_view text){
+        std::cerr << text << "\n";
     });
 
     window.setMouseClickHandler([](const glfwW::Window&, glfwW::MouseButtonEvent event){
@@ -0,0 +1,471 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "capture.h"
+
+namespace
+{
+
+int failures = 0;
+
+#define CHECK(condition) \
+    if(!(condition)) \
+    { \
+        std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition "\n"; \
+        ++failures; \
+    }
+
+glfwW::Frame makeFrame(glfwW::Vec2<int> size, glfwW::PixelFormat format, uint64_t index)
+{
+    glfwW::Frame frame;
+    frame.size = size;
+    frame.format = format;
+    frame.index = index;
+    frame.pixels.resize(static_cast<size_t>(size.x) * size.y * glfwW::bytesPerPixel(format));
+    // A mix of runs, small and large differences to exercise all QOI chunks
+    for(size_t i = 0; i < frame.pixels.size(); ++i)
+    {
+        const size_t pixel = i / glfwW::bytesPerPixel(format);
+        frame.pixels[i] = pixel % 7 < 3 ? 40 : static_cast<unsigned char>((i * 31 + index * 17) ^ (i >> 5));
+    }
+    return frame;
+}
+
+// Returns the pixels of a frame as a top-down image
+std::vector<unsigned char> flipped(const glfwW::Frame& frame)
+{
+    const size_t rowSize = static_cast<size_t>(frame.size.x) * glfwW::bytesPerPixel(frame.format);
+    std::vector<unsigned char> result;
+    for(int y = frame.size.y - 1; y >= 0; --y)
+    {
+        const auto row = frame.pixels.begin() + static_cast<ptrdiff_t>(y * rowSize);
+        result.insert(result.end(), row, row + static_cast<ptrdiff_t>(rowSize));
+    }
+    return result;
+}
+
+uint32_t readBigEndian(const unsigned char* data)
+{
+    return static_cast<uint32_t>(data[0]) << 24 | static_cast<uint32_t>(data[1]) << 16 |
+           static_cast<uint32_t>(data[2]) << 8 | data[3];
+}
+
+uint32_t crc32(const unsigned char* data, size_t size)
+{
+    uint32_t c = 0xFFFFFFFFu;
+    for(size_t i = 0; i < size; ++i)
+    {
+        c ^= data[i];
+        for(int k = 0; k < 8; ++k)
+        {
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        }
+    }
+    return c ^ 0xFFFFFFFFu;
+}
+
+/*!
+ * \brief Decodes an 8-bit PNG without interlacing whose zlib stream is made of stored blocks and whose rows are unfiltered.
+ * Returns false if the file is malformed.
+ */
+bool decodePNG(const std::vector<unsigned char>& file, glfwW::Vec2<int>& size, int& channels, std::vector<unsigned char>& pixels)
+{
+    static const unsigned char signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    if(file.size() < 8 || std::memcmp(file.data(), signature, 8) != 0)
+    {
+        return false;
+    }
+
+    std::vector<unsigned char> zlib;
+    bool ended = false;
+    for(size_t offset = 8; offset < file.size() && !ended;)
+    {
+        if(file.size() - offset < 12)
+        {
+            return false;
+        }
+        const uint32_t length = readBigEndian(&file[offset]);
+        const std::string type(file.begin() + static_cast<ptrdiff_t>(offset + 4), file.begin() + static_cast<ptrdiff_t>(offset + 8));
+        if(file.size() - offset < 12 + static_cast<size_t>(length) ||
+           crc32(&file[offset + 4], length + 4) != readBigEndian(&file[offset + 8 + length]))
+        {
+            return false;
+        }
+        const unsigned char* data = &file[offset + 8];
+        if(type == "IHDR")
+        {
+            size = {static_cast<int>(readBigEndian(data)), static_cast<int>(readBigEndian(data + 4))};
+            if(data[8] != 8 || (data[9] != 2 && data[9] != 6) || data[12] != 0)
+            {
+                return false;
+            }
+            channels = data[9] == 6 ? 4 : 3;
+        }
+        else if(type == "IDAT")
+        {
+            zlib.insert(zlib.end(), data, data + length);
+        }
+        else if(type == "IEND")
+        {
+            ended = true;
+        }
+        offset += 12 + length;
+    }
+    if(!ended || zlib.size() < 6 || zlib[0] != 0x78 || (zlib[0] * 256 + zlib[1]) % 31 != 0)
+    {
+        return false;
+    }
+
+    std::vector<unsigned char> raw;
+    size_t offset = 2;
+    bool final = false;
+    while(!final)
+    {
+        if(zlib.size() - offset < 5 || (zlib[offset] & 0x06) != 0)
+        {
+            return false;
+        }
+        final = zlib[offset] & 1;
+        const unsigned length = zlib[offset + 1] | zlib[offset + 2] << 8;
+        const unsigned complement = zlib[offset + 3] | zlib[offset + 4] << 8;
+        offset += 5;
+        if((length ^ 0xFFFF) != complement || zlib.size() - offset < length)
+        {
+            return false;
+        }
+        raw.insert(raw.end(), zlib.begin() + static_cast<ptrdiff_t>(offset), zlib.begin() + static_cast<ptrdiff_t>(offset + length));
+        offset += length;
+    }
+    uint32_t a = 1;
+    uint32_t b = 0;
+    for(const unsigned char byte : raw)
+    {
+        a = (a + byte) % 65521;
+        b = (b + a) % 65521;
+    }
+    if(zlib.size() - offset != 4 || readBigEndian(&zlib[offset]) != (b << 16 | a))
+    {
+        return false;
+    }
+
+    const size_t rowSize = static_cast<size_t>(size.x) * channels;
+    if(raw.size() != (rowSize + 1) * size.y)
+    {
+        return false;
+    }
+    pixels.clear();
+    for(int y = 0; y < size.y; ++y)
+    {
+        const auto row = raw.begin() + static_cast<ptrdiff_t>(y * (rowSize + 1));
+        if(*row != 0)
+        {
+            return false;
+        }
+        pixels.insert(pixels.end(), row + 1, row + 1 + static_cast<ptrdiff_t>(rowSize));
+    }
+    return true;
+}
+
+/*!
+ * \brief Decodes a QOI image following the specification. Returns false if the file is malformed.
+ */
+bool decodeQOI(const std::vector<unsigned char>& file, glfwW::Vec2<int>& size, int& channels, std::vector<unsigned char>& pixels)
+{
+    static const unsigned char end[] = {0, 0, 0, 0, 0, 0, 0, 1};
+    if(file.size() < 22 || std::memcmp(file.data(), "qoif", 4) != 0 ||
+       std::memcmp(file.data() + file.size() - 8, end, 8) != 0)
+    {
+        return false;
+    }
+    size = {static_cast<int>(readBigEndian(&file[4])), static_cast<int>(readBigEndian(&file[8]))};
+    channels = file[12];
+
+    unsigned char index[64][4] = {};
+    unsigned char pixel[4] = {0, 0, 0, 255};
+    const size_t pixelCount = static_cast<size_t>(size.x) * size.y;
+    pixels.clear();
+    size_t offset = 14;
+    const size_t dataEnd = file.size() - 8;
+    int run = 0;
+    for(size_t i = 0; i < pixelCount; ++i)
+    {
+        if(run > 0)
+        {
+            --run;
+        }
+        else
+        {
+            if(offset >= dataEnd)
+            {
+                return false;
+            }
+            const unsigned char tag = file[offset++];
+            if(tag == 0xFE)
+            {
+                std::memcpy(pixel, &file[offset], 3);
+                offset += 3;
+            }
+            else if(tag == 0xFF)
+            {
+                std::memcpy(pixel, &file[offset], 4);
+                offset += 4;
+            }
+            else if((tag & 0xC0) == 0x00)
+            {
+                std::memcpy(pixel, index[tag], 4);
+            }
+            else if((tag & 0xC0) == 0x40)
+            {
+                pixel[0] += ((tag >> 4) & 3) - 2;
+                pixel[1] += ((tag >> 2) & 3) - 2;
+                pixel[2] += (tag & 3) - 2;
+            }
+            else if((tag & 0xC0) == 0x80)
+            {
+                const int dg = (tag & 0x3F) - 32;
+                const unsigned char next = file[offset++];
+                pixel[0] += dg + ((next >> 4) & 0x0F) - 8;
+                pixel[1] += dg;
+                pixel[2] += dg + (next & 0x0F) - 8;
+            }
+            else
+            {
+                run = tag & 0x3F;
+            }
+            std::memcpy(index[(pixel[0] * 3 + pixel[1] * 5 + pixel[2] * 7 + pixel[3] * 11) % 64], pixel, 4);
+        }
+        pixels.insert(pixels.end(), pixel, pixel + channels);
+    }
+    return offset == dataEnd && run == 0;
+}
+
+void testPNG()
+{
+    for(const auto format : {glfwW::PixelFormat::RGBA, glfwW::PixelFormat::RGB})
+    {
+        // 200 * 120 * 4 bytes need several stored blocks
+        for(const glfwW::Vec2<int> size : {glfwW::Vec2<int>{1, 1}, glfwW::Vec2<int>{17, 5}, glfwW::Vec2<int>{200, 120}})
+        {
+            const auto frame = makeFrame(size, format, 1);
+            for(const bool flip : {false, true})
+            {
+                std::vector<unsigned char> file;
+                glfwW::encodePNG(frame, flip, file);
+                glfwW::Vec2<int> decodedSize;
+                int channels = 0;
+                std::vector<unsigned char> pixels;
+                CHECK(decodePNG(file, decodedSize, channels, pixels));
+                CHECK(decodedSize.x == size.x && decodedSize.y == size.y);
+                CHECK(channels == glfwW::bytesPerPixel(format));
+                CHECK(pixels == (flip ? flipped(frame) : frame.pixels));
+            }
+        }
+    }
+}
+
+void testQOI()
+{
+    for(const auto format : {glfwW::PixelFormat::RGBA, glfwW::PixelFormat::RGB})
+    {
+        for(const glfwW::Vec2<int> size : {glfwW::Vec2<int>{1, 1}, glfwW::Vec2<int>{17, 5}, glfwW::Vec2<int>{200, 120}})
+        {
+            const auto frame = makeFrame(size, format, 2);
+            for(const bool flip : {false, true})
+            {
+                std::vector<unsigned char> file;
+                glfwW::encodeQOI(frame, flip, file);
+                glfwW::Vec2<int> decodedSize;
+                int channels = 0;
+                std::vector<unsigned char> pixels;
+                CHECK(decodeQOI(file, decodedSize, channels, pixels));
+                CHECK(decodedSize.x == size.x && decodedSize.y == size.y);
+                CHECK(channels == glfwW::bytesPerPixel(format));
+                CHECK(pixels == (flip ? flipped(frame) : frame.pixels));
+            }
+        }
+    }
+
+    // Runs longer than 62 pixels are split
+    glfwW::Frame uniform;
+    uniform.size = {100, 3};
+    uniform.pixels.assign(100 * 3 * 4, 9);
+    std::vector<unsigned char> file;
+    glfwW::encodeQOI(uniform, false, file);
+    glfwW::Vec2<int> decodedSize;
+    int channels = 0;
+    std::vector<unsigned char> pixels;
+    CHECK(decodeQOI(file, decodedSize, channels, pixels));
+    CHECK(pixels == uniform.pixels);
+}
+
+void testY4M()
+{
+    const auto header = glfwW::y4mHeader({33, 17}, 60);
+    CHECK(std::string(header.begin(), header.end()) == "YUV4MPEG2 W33 H17 F60:1 Ip A1:1 C420jpeg XYSCSS=420JPEG\n");
+
+    // Gray has no chroma, white and black reach the ends of the full range
+    for(const unsigned char value : {0, 128, 255})
+    {
+        glfwW::Frame frame;
+        frame.size = {33, 17};
+        frame.format = glfwW::PixelFormat::RGB;
+        frame.pixels.assign(33 * 17 * 3, value);
+        std::vector<unsigned char> output;
+        glfwW::encodeY4MFrame(frame, true, output);
+        const size_t lumaSize = 33 * 17;
+        const size_t chromaSize = 17 * 9;
+        CHECK(output.size() == 6 + lumaSize + chromaSize * 2);
+        CHECK(std::string(output.begin(), output.begin() + 6) == "FRAME\n");
+        CHECK(std::all_of(output.begin() + 6, output.begin() + 6 + lumaSize, [value](unsigned char luma){return luma == value;}));
+        CHECK(std::all_of(output.begin() + 6 + lumaSize, output.end(), [](unsigned char chroma){return chroma == 128;}));
+    }
+}
+
+void testOrder()
+{
+    std::vector<uint64_t> delivered;
+    bool decoded = true;
+    glfwW::CaptureSettings settings;
+    settings.format = glfwW::CaptureFormat::QOI;
+    settings.workerCount = 4;
+    settings.dropPolicy = glfwW::DropPolicy::BLOCK;
+    {
+        // Frames of very different sizes finish out of order
+        glfwW::FrameCapture capture(settings, [&](const glfwW::Frame& frame, const std::vector<unsigned char>& encoded){
+            delivered.push_back(frame.index);
+            glfwW::Vec2<int> size;
+            int channels = 0;
+            std::vector<unsigned char> pixels;
+            decoded = decoded && decodeQOI(encoded, size, channels, pixels) && pixels == flipped(frame);
+        });
+        for(uint64_t i = 0; i < 64; ++i)
+        {
+            const int side = i % 4 == 0 ? 256 : 4;
+            CHECK(capture.submit(makeFrame({side, side}, glfwW::PixelFormat::RGBA, i)));
+        }
+        capture.finish();
+        CHECK(delivered.size() == 64);
+        CHECK(capture.droppedFrames() == 0);
+    }
+    CHECK(decoded);
+    for(uint64_t i = 0; i < delivered.size(); ++i)
+    {
+        CHECK(delivered[i] == i);
+    }
+}
+
+/*!
+ * \brief Holds the only worker in the output handler, so submitted frames stay queued
+ */
+class StalledCapture
+{
+public:
+    explicit StalledCapture(glfwW::DropPolicy policy)
+    {
+        glfwW::CaptureSettings settings;
+        settings.workerCount = 1;
+        settings.maxPendingFrames = 2;
+        settings.dropPolicy = policy;
+        capture.reset(new glfwW::FrameCapture(settings, [this](const glfwW::Frame& frame, const std::vector<unsigned char>&){
+            std::unique_lock<std::mutex> lock(mutex);
+            delivered.push_back(frame.index);
+            stalled = true;
+            changed.notify_all();
+            changed.wait(lock, [this]{return released;});
+        }));
+        // The first frame occupies the worker, the next two fill the queue
+        capture->submit(makeFrame({2, 2}, glfwW::PixelFormat::RGBA, 0));
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this]{return stalled;});
+        lock.unlock();
+        capture->submit(makeFrame({2, 2}, glfwW::PixelFormat::RGBA, 1));
+        capture->submit(makeFrame({2, 2}, glfwW::PixelFormat::RGBA, 2));
+    }
+
+    void release()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            released = true;
+        }
+        changed.notify_all();
+        capture->finish();
+    }
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    bool stalled = false;
+    bool released = false;
+    std::vector<uint64_t> delivered;
+    std::unique_ptr<glfwW::FrameCapture> capture;
+};
+
+void testDropPolicies()
+{
+    {
+        StalledCapture stalled(glfwW::DropPolicy::DROP_NEWEST);
+        auto frame = makeFrame({2, 2}, glfwW::PixelFormat::RGBA, 3);
+        CHECK(!stalled.capture->submit(std::move(frame)));
+        // A dropped frame is left to the caller
+        CHECK(frame.pixels.size() == 16);
+        CHECK(stalled.capture->droppedFrames() == 1);
+        stalled.release();
+        CHECK((stalled.delivered == std::vector<uint64_t>{0, 1, 2}));
+    }
+    {
+        StalledCapture stalled(glfwW::DropPolicy::DROP_OLDEST);
+        CHECK(stalled.capture->submit(makeFrame({2, 2}, glfwW::PixelFormat::RGBA, 3)));
+        CHECK(stalled.capture->submit(makeFrame({2, 2}, glfwW::PixelFormat::RGBA, 4)));
+        CHECK(stalled.capture->droppedFrames() == 2);
+        // The storage of dropped frames is offered for reuse
+        std::vector<unsigned char> storage;
+        CHECK(stalled.capture->reclaimStorage(storage));
+        CHECK(storage.size() == 16);
+        stalled.release();
+        CHECK((stalled.delivered == std::vector<uint64_t>{0, 3, 4}));
+    }
+    {
+        StalledCapture stalled(glfwW::DropPolicy::BLOCK);
+        std::atomic<bool> submitted = {false};
+        std::thread producer([&]{
+            stalled.capture->submit(makeFrame({2, 2}, glfwW::PixelFormat::RGBA, 3));
+            submitted = true;
+        });
+        // The producer can't get past a full queue while the worker is held
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        CHECK(!submitted);
+        stalled.release();
+        producer.join();
+        stalled.capture->finish();
+        CHECK(submitted);
+        CHECK(stalled.capture->droppedFrames() == 0);
+        CHECK((stalled.delivered == std::vector<uint64_t>{0, 1, 2, 3}));
+    }
+}
+
+}
+
+int main()
+{
+    testPNG();
+    testQOI();
+    testY4M();
+    testOrder();
+    testDropPolicies();
+
+    if(failures)
+    {
+        std::cerr << failures << " checks failed\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,108 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "glfwlibrary.h"
+
+namespace
+{
+
+int failures = 0;
+
+#define CHECK(condition) \
+    if(!(condition)) \
+    { \
+        std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition "\n"; \
+        ++failures; \
+    }
+
+// CTest reports the test as skipped, see SKIP_RETURN_CODE
+constexpr int SKIPPED = 77;
+
+// Another application writing the clipboard, GLFW doesn't report it
+void writeExternally(const char* text)
+{
+    glfwSetClipboardString(nullptr, text);
+}
+
+void testFetchedWhileFocused(glfwW::GLFWlibrary& lib)
+{
+    lib.setClipboardString("ours");
+    CHECK(lib.getClipboardString() == "ours");
+    writeExternally("theirs");
+    CHECK(lib.getClipboardString() == "theirs");
+    writeExternally("theirs again");
+    CHECK(lib.getClipboardString() == "theirs again");
+}
+
+void testCaching(glfwW::GLFWlibrary& lib, const glfwW::Window& window)
+{
+    lib.setClipboardCaching(true);
+    lib.setClipboardString("ours");
+    writeExternally("theirs");
+    // The cache is kept while the window stays focused
+    CHECK(lib.getClipboardString() == "ours");
+    lib.invalidateClipboardCache();
+    CHECK(lib.getClipboardString() == "theirs");
+
+    // Focus changes drop the cache
+    writeExternally("after focus loss");
+    glfwW::windowFocusCallback(window.getHandler(), GLFW_FALSE);
+    CHECK(lib.getClipboardString() == "after focus loss");
+    glfwW::windowFocusCallback(window.getHandler(), GLFW_TRUE);
+    writeExternally("after focus gain");
+    CHECK(lib.getClipboardString() == "after focus gain");
+    lib.setClipboardCaching(false);
+}
+
+void testReading(glfwW::GLFWlibrary& lib)
+{
+    writeExternally("0123456789");
+    char buffer[4] = {};
+    CHECK(lib.readClipboard(8, buffer, sizeof(buffer)) == 2);
+    CHECK(std::string(buffer, 2) == "89");
+    CHECK(lib.readClipboard(10, buffer, sizeof(buffer)) == 0);
+
+    std::string chunks;
+    lib.readClipboardChunks(3, [&chunks](std::string_view chunk){
+        chunks.append(chunk).push_back('|');
+    });
+    CHECK(chunks == "012|345|678|9|");
+}
+
+}
+
+int main()
+{
+    auto& lib = glfwW::GLFWlibrary::instance();
+    glfwW::GLFWlibrary::InitHints hints;
+    hints.platform = glfwW::Platform::NULL_PLATFORM;
+    const auto error = lib.init(hints);
+    if(error.code != glfwW::ErrorCode::NO_ERROR)
+    {
+        std::cerr << "skipped, the null platform is unavailable: " << error.description << "\n";
+        return SKIPPED;
+    }
+
+    {
+        glfwW::WindowCreationHints windowHints;
+        windowHints.addHint<glfwW::WindowHint::VISIBLE>(false).addHint<glfwW::WindowHint::CLIENT_API>(glfwW::ClientAPI::NO_API);
+        glfwW::Window window = lib.createWindow(windowHints, {64, 64}, "glfwW clipboard test");
+        CHECK(window.valid());
+        if(window.valid())
+        {
+            // Hidden windows aren't focused on creation
+            glfwW::windowFocusCallback(window.getHandler(), GLFW_TRUE);
+            testFetchedWhileFocused(lib);
+            testCaching(lib, window);
+            testReading(lib);
+        }
+    }
+    lib.deinit();
+
+    if(failures)
+    {
+        std::cerr << failures << " checks failed\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,180 @@
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <vector>
+#include "coroutine.h"
+#include "waiter.h"
+
+#ifndef GLFWW_HAS_COROUTINES
+#error "The coroutine test requires C++20 coroutines, configure with GLFWW_ENABLE_COROUTINES"
+#endif
+
+namespace
+{
+
+int failures = 0;
+
+#define CHECK(condition) \
+    if(!(condition)) \
+    { \
+        std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition "\n"; \
+        ++failures; \
+    }
+
+struct Event
+{
+    int value = 0;
+};
+
+using Waiters = glfwW::WaiterList<Event>;
+
+struct Result
+{
+    int resumed = 0;
+    int value = -1;
+    bool cancelled = false;
+};
+
+// Records the resumption order of all coroutines of a test
+std::vector<int> order;
+
+glfwW::Coroutine awaitEvents(Waiters* waiters, Result& result, int id, int count = 1)
+{
+    for(int i = 0; i < count; ++i)
+    {
+        glfwW::EventAwaiter<Event> awaiter(waiters);
+        const auto event = co_await awaiter;
+        order.push_back(id);
+        ++result.resumed;
+        result.value = event.value;
+        result.cancelled = awaiter.cancelled();
+    }
+}
+
+void testNotify()
+{
+    order.clear();
+    Waiters waiters;
+    Result first, second;
+    glfwW::EventLoopExecutor executor;
+    executor.spawn(awaitEvents(&waiters, first, 1));
+    executor.spawn(awaitEvents(&waiters, second, 2, 2));
+    CHECK(!waiters.empty());
+    CHECK(first.resumed == 0);
+
+    waiters.notify(Event{7});
+    CHECK(first.resumed == 1 && first.value == 7 && !first.cancelled);
+    // The second coroutine waits again and is resumed by the next event only
+    CHECK(second.resumed == 1 && second.value == 7 && !second.cancelled);
+    CHECK((order == std::vector<int>{1, 2}));
+    CHECK(!waiters.empty());
+
+    waiters.notify(Event{8});
+    CHECK(first.resumed == 1 && first.value == 7);
+    CHECK(second.resumed == 2 && second.value == 8);
+    CHECK(waiters.empty());
+}
+
+void testCancel()
+{
+    Waiters waiters;
+    Result result;
+    glfwW::EventLoopExecutor executor;
+    executor.spawn(awaitEvents(&waiters, result, 1));
+    waiters.cancel();
+    CHECK(result.resumed == 1 && result.cancelled && result.value == 0);
+    CHECK(waiters.empty());
+
+    // Awaiting an invalid source completes at once
+    Result invalid;
+    executor.spawn(awaitEvents(nullptr, invalid, 2));
+    CHECK(invalid.resumed == 1 && invalid.cancelled);
+}
+
+void testDestroySuspended()
+{
+    Waiters waiters;
+    Result result;
+    {
+        glfwW::EventLoopExecutor executor;
+        executor.spawn(awaitEvents(&waiters, result, 1));
+        CHECK(!waiters.empty());
+    }
+    // Destroying the coroutine unlinked its awaiter
+    CHECK(waiters.empty());
+    waiters.notify(Event{1});
+    CHECK(result.resumed == 0);
+
+    // A source destroyed first leaves the waiter cancelled without resuming it
+    {
+        glfwW::EventLoopExecutor executor;
+        {
+            Waiters source;
+            executor.spawn(awaitEvents(&source, result, 2));
+        }
+        CHECK(result.resumed == 0);
+    }
+}
+
+std::optional<glfwW::EventLoopExecutor> victim;
+std::optional<Waiters> source;
+
+glfwW::Coroutine destroyVictim(Waiters& waiters, Result& result)
+{
+    co_await glfwW::EventAwaiter<Event>(&waiters);
+    ++result.resumed;
+    victim.reset();
+}
+
+glfwW::Coroutine destroySource(Result& result)
+{
+    co_await glfwW::EventAwaiter<Event>(&*source);
+    ++result.resumed;
+    source.reset();
+}
+
+void testDestroyWhileResuming()
+{
+    // A resumed coroutine destroys another coroutine waiting for the same event
+    Waiters waiters;
+    Result killer, killed;
+    glfwW::EventLoopExecutor executor;
+    executor.spawn(destroyVictim(waiters, killer));
+    victim.emplace();
+    victim->spawn(awaitEvents(&waiters, killed, 2));
+    Result last;
+    executor.spawn(awaitEvents(&waiters, last, 3));
+
+    waiters.notify(Event{5});
+    CHECK(killer.resumed == 1);
+    CHECK(killed.resumed == 0);
+    CHECK(last.resumed == 1 && last.value == 5);
+    CHECK(waiters.empty());
+
+    // A resumed coroutine destroys the source of the event
+    source.emplace();
+    Result owner, other;
+    executor.spawn(destroySource(owner));
+    executor.spawn(awaitEvents(&*source, other, 2));
+    source->notify(Event{6});
+    CHECK(owner.resumed == 1);
+    CHECK(other.resumed == 1 && other.value == 6);
+    CHECK(!source);
+}
+
+}
+
+int main()
+{
+    testNotify();
+    testCancel();
+    testDestroySuspended();
+    testDestroyWhileResuming();
+
+    if(failures)
+    {
+        std::cerr << failures << " checks failed\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
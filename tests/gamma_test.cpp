@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include "gamma.h"
+
+namespace
+{
+
+int failures = 0;
+
+#define CHECK(condition) \
+    if(!(condition)) \
+    { \
+        std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition "\n"; \
+        ++failures; \
+    }
+
+// 256 and 4096 are the ramp sizes of common hardware, 1001 leaves a tail after the four-wide loop
+const size_t SIZES[] = {256, 4096, 1001};
+
+unsigned short reference(const glfwW::GammaParameters& parameters, size_t index, size_t size)
+{
+    const double value = static_cast<double>(index) / static_cast<double>(size - 1);
+    double curve = std::pow(value, 1.0 / parameters.gamma);
+    curve = (curve - 0.5) * parameters.contrast + 0.5 + parameters.brightness;
+    curve = std::min(std::max(curve, 0.0), 1.0);
+    return static_cast<unsigned short>(std::lround(curve * 65535.0));
+}
+
+// Returns the largest difference to the reference in units of the last place
+int maxError(const glfwW::GammaParameters& parameters, size_t size)
+{
+    std::vector<unsigned short> table(size);
+    glfwW::buildGammaCurve(parameters, table.data(), size);
+    int result = 0;
+    for(size_t i = 0; i < size; ++i)
+    {
+        result = std::max(result, std::abs(static_cast<int>(table[i]) - reference(parameters, i, size)));
+    }
+    return result;
+}
+
+void testAccuracy()
+{
+    for(const float gamma : {0.5f, 1.0f, 1.8f, 2.2f, 3.0f})
+    {
+        for(const size_t size : SIZES)
+        {
+            glfwW::GammaParameters parameters;
+            parameters.gamma = gamma;
+            CHECK(maxError(parameters, size) <= 1);
+            parameters.brightness = 0.1f;
+            parameters.contrast = 0.8f;
+            CHECK(maxError(parameters, size) <= 1);
+        }
+    }
+}
+
+void testClamping()
+{
+    for(const size_t size : SIZES)
+    {
+        std::vector<unsigned short> table(size);
+        glfwW::GammaParameters parameters;
+
+        parameters.brightness = 1.0f;
+        glfwW::buildGammaCurve(parameters, table.data(), size);
+        CHECK(std::all_of(table.begin(), table.end(), [](unsigned short value){return value == 65535;}));
+
+        parameters.brightness = -1.0f;
+        glfwW::buildGammaCurve(parameters, table.data(), size);
+        CHECK(std::all_of(table.begin(), table.end(), [](unsigned short value){return value == 0;}));
+
+        // A steep curve saturates at both ends and stays monotonic
+        parameters.brightness = 0.0f;
+        parameters.contrast = 4.0f;
+        glfwW::buildGammaCurve(parameters, table.data(), size);
+        CHECK(table.front() == 0);
+        CHECK(table.back() == 65535);
+        CHECK(table[size / 8] == 0);
+        CHECK(table[size - 1 - size / 8] == 65535);
+        CHECK(std::is_sorted(table.begin(), table.end()));
+        CHECK(maxError(parameters, size) <= 1);
+    }
+}
+
+void testInvalidParameters()
+{
+    std::vector<unsigned short> table(256, 7);
+    glfwW::GammaParameters parameters;
+    parameters.gamma = 0.0f;
+    glfwW::buildGammaCurve(parameters, table.data(), table.size());
+    CHECK(std::all_of(table.begin(), table.end(), [](unsigned short value){return value == 7;}));
+
+    CHECK(glfwW::buildGammaRamp(glfwW::GammaParameters(), 16).size() == glfwW::GammaRamp::MIN_SIZE);
+    CHECK(glfwW::buildGammaRamp(glfwW::GammaParameters(), 100000).size() == glfwW::GammaRamp::MAX_SIZE);
+}
+
+}
+
+int main()
+{
+    testAccuracy();
+    testClamping();
+    testInvalidParameters();
+
+    if(failures)
+    {
+        std::cerr << failures << " checks failed\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
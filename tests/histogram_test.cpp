@@ -0,0 +1,153 @@
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "histogram.h"
+
+namespace
+{
+
+int failures = 0;
+
+#define CHECK(condition) \
+    if(!(condition)) \
+    { \
+        std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition "\n"; \
+        ++failures; \
+    }
+
+using Layout = glfwW::HistogramLayout;
+
+// A bucket is never wider than 1/32 of its values
+bool withinPrecision(uint64_t value, uint64_t expected)
+{
+    return value >= expected && value <= expected + expected / 32;
+}
+
+void testLayout()
+{
+    for(uint64_t value = 0; value < Layout::SUB_BUCKET_COUNT; ++value)
+    {
+        CHECK(Layout::bucketIndex(value) == value);
+        CHECK(Layout::bucketUpperBound(value) == value);
+    }
+
+    // Every bucket ends right before the next one starts
+    bool roundTrips = true;
+    for(size_t index = 0; index + 1 < Layout::BUCKET_COUNT; ++index)
+    {
+        const uint64_t bound = Layout::bucketUpperBound(index);
+        roundTrips = roundTrips && Layout::bucketIndex(bound) == index && Layout::bucketIndex(bound + 1) == index + 1;
+    }
+    CHECK(roundTrips);
+    // The last bucket of the largest range also takes all values beyond it
+    CHECK(Layout::bucketIndex((uint64_t(1) << Layout::MAX_VALUE_BITS) - 1) == Layout::BUCKET_COUNT - 1);
+
+    bool precise = true;
+    for(uint64_t value = 1; value < (uint64_t(1) << Layout::MAX_VALUE_BITS); value = value * 3 / 2 + 1)
+    {
+        precise = precise && withinPrecision(Layout::bucketUpperBound(Layout::bucketIndex(value)), value);
+    }
+    CHECK(precise);
+
+    CHECK(Layout::bucketIndex(uint64_t(1) << Layout::MAX_VALUE_BITS) == Layout::BUCKET_COUNT - 1);
+    CHECK(Layout::bucketIndex(UINT64_MAX) == Layout::BUCKET_COUNT - 1);
+    CHECK(Layout::bucketUpperBound(Layout::BUCKET_COUNT - 1) == UINT64_MAX);
+}
+
+void testPercentiles()
+{
+    glfwW::Histogram histogram;
+    CHECK(histogram.snapshot().percentile(50) == 0);
+
+    for(uint64_t value = 1; value <= 1000; ++value)
+    {
+        histogram.record(value);
+    }
+    const auto snapshot = histogram.snapshot();
+    CHECK(snapshot.count() == 1000);
+    CHECK(snapshot.min() == 1);
+    CHECK(snapshot.max() == 1000);
+    CHECK(snapshot.mean() == 500.5);
+    CHECK(snapshot.percentile(0) == 1);
+    CHECK(withinPrecision(snapshot.percentile(50), 500));
+    CHECK(withinPrecision(snapshot.percentile(99), 990));
+    CHECK(snapshot.percentile(99.9) == 1000);
+    CHECK(snapshot.percentile(100) == 1000);
+    CHECK(snapshot.percentile(200) == 1000);
+
+    histogram.reset();
+    const auto cleared = histogram.snapshot();
+    CHECK(cleared.count() == 0 && cleared.min() == 0 && cleared.max() == 0 && cleared.mean() == 0.0);
+}
+
+void testMerge()
+{
+    glfwW::Histogram low;
+    glfwW::Histogram high;
+    for(uint64_t value = 10; value < 20; ++value)
+    {
+        low.record(value);
+        high.record(value * 1000);
+    }
+
+    glfwW::HistogramSnapshot merged;
+    merged.merge(low.snapshot());
+    merged.merge(high.snapshot());
+    merged.merge(glfwW::HistogramSnapshot());
+    CHECK(merged.count() == 20);
+    CHECK(merged.min() == 10);
+    CHECK(merged.max() == 19000);
+    CHECK(merged.mean() == (145.0 + 145000.0) / 20);
+    CHECK(merged.bucket(Layout::bucketIndex(15)) == 1);
+    CHECK(merged.percentile(50) == 19);
+    CHECK(withinPrecision(merged.percentile(55), 10000));
+
+    merged.reset();
+    CHECK(merged.count() == 0 && merged.min() == 0);
+}
+
+void testConcurrentRecording()
+{
+    constexpr unsigned THREAD_COUNT = 4;
+    constexpr uint64_t VALUES_PER_THREAD = 100000;
+    glfwW::Histogram histogram;
+    std::vector<std::thread> threads;
+    for(unsigned thread = 0; thread < THREAD_COUNT; ++thread)
+    {
+        threads.emplace_back([&histogram, thread]{
+            for(uint64_t i = 0; i < VALUES_PER_THREAD; ++i)
+            {
+                histogram.record(thread * VALUES_PER_THREAD + i + 1);
+            }
+        });
+    }
+    for(auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    const uint64_t total = THREAD_COUNT * VALUES_PER_THREAD;
+    const auto snapshot = histogram.snapshot();
+    CHECK(snapshot.count() == total);
+    CHECK(snapshot.min() == 1);
+    CHECK(snapshot.max() == total);
+    CHECK(snapshot.mean() == (total + 1) / 2.0);
+}
+
+}
+
+int main()
+{
+    testLayout();
+    testPercentiles();
+    testMerge();
+    testConcurrentRecording();
+
+    if(failures)
+    {
+        std::cerr << failures << " checks failed\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,141 @@
+#include <cstdlib>
+#include <iostream>
+#include "latency.h"
+
+namespace
+{
+
+int failures = 0;
+
+#define CHECK(condition) \
+    if(!(condition)) \
+    { \
+        std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition "\n"; \
+        ++failures; \
+    }
+
+// One tick is a millisecond, so the histograms hold multiples of 1000 microseconds
+constexpr uint64_t FREQUENCY = 1000;
+
+// A bucket is never wider than 1/32 of its values
+bool withinPrecision(uint64_t value, uint64_t expected)
+{
+    return value >= expected && value <= expected + expected / 32;
+}
+
+void testAttribution()
+{
+    glfwW::LatencyTracker tracker(FREQUENCY);
+    tracker.onEvent(0);
+    tracker.onEvent(5);
+    tracker.onSwap(10);
+    tracker.onSwap(26);
+    tracker.onEvent(30);
+    tracker.onSwap(42);
+    tracker.onEvent(50);
+
+    const auto statistics = tracker.statistics();
+    CHECK(statistics.eventToSwap.count() == 3);
+    CHECK(statistics.eventToSwap.min() == 5000);
+    CHECK(statistics.eventToSwap.max() == 12000);
+    CHECK(withinPrecision(statistics.eventToSwap.percentile(50), 10000));
+    CHECK(statistics.eventToSwap.percentile(100) == 12000);
+    CHECK(statistics.frameInterval.count() == 2);
+    CHECK(statistics.frameInterval.min() == 16000);
+    CHECK(statistics.frameInterval.max() == 16000);
+    CHECK(statistics.pendingEvents == 1);
+    CHECK(statistics.droppedEvents == 0);
+}
+
+void testPercentiles()
+{
+    glfwW::LatencyTracker tracker(FREQUENCY);
+    // 100 frames of 16 ms with one event 1 - 100 ms before each swap
+    uint64_t time = 1000;
+    for(uint64_t i = 1; i <= 100; ++i)
+    {
+        tracker.onEvent(time - i);
+        tracker.onSwap(time);
+        time += 16;
+    }
+
+    const auto statistics = tracker.statistics();
+    CHECK(statistics.eventToSwap.count() == 100);
+    CHECK(statistics.eventToSwap.min() == 1000);
+    CHECK(statistics.eventToSwap.max() == 100000);
+    CHECK(withinPrecision(statistics.eventToSwap.percentile(50), 50000));
+    CHECK(withinPrecision(statistics.eventToSwap.percentile(99), 99000));
+    CHECK(statistics.eventToSwap.mean() == 50500.0);
+    CHECK(statistics.frameInterval.count() == 99);
+    CHECK(statistics.frameInterval.percentile(99) == 16000);
+    CHECK(statistics.pendingEvents == 0);
+}
+
+void testTimerConversion()
+{
+    // 3 ticks per second: a tick is 333333 microseconds, and 2^40 ticks mustn't overflow
+    glfwW::LatencyTracker tracker(3);
+    tracker.onEvent(0);
+    tracker.onSwap(1);
+    tracker.onSwap(1 + (uint64_t(1) << 40));
+
+    const auto statistics = tracker.statistics();
+    CHECK(statistics.eventToSwap.min() == 333333);
+    CHECK(statistics.frameInterval.max() == (uint64_t(1) << 40) / 3 * 1000000 + (uint64_t(1) << 40) % 3 * 1000000 / 3);
+}
+
+void testEventAfterSwapTime()
+{
+    // Timestamps of events and swaps may come from different sources, so an event can appear to be later than its swap
+    glfwW::LatencyTracker tracker(FREQUENCY);
+    tracker.onEvent(20);
+    tracker.onSwap(10);
+
+    const auto statistics = tracker.statistics();
+    CHECK(statistics.eventToSwap.count() == 1);
+    CHECK(statistics.eventToSwap.max() == 0);
+}
+
+void testPendingEventsLimit()
+{
+    glfwW::LatencyTracker tracker(FREQUENCY);
+    for(size_t i = 0; i < glfwW::LatencyTracker::MAX_PENDING_EVENTS + 10; ++i)
+    {
+        tracker.onEvent(i);
+    }
+
+    auto statistics = tracker.statistics();
+    CHECK(statistics.pendingEvents == glfwW::LatencyTracker::MAX_PENDING_EVENTS);
+    CHECK(statistics.droppedEvents == 10);
+    CHECK(statistics.eventToSwap.count() == 0);
+
+    tracker.onSwap(glfwW::LatencyTracker::MAX_PENDING_EVENTS);
+    statistics = tracker.statistics();
+    CHECK(statistics.pendingEvents == 0);
+    CHECK(statistics.eventToSwap.count() == glfwW::LatencyTracker::MAX_PENDING_EVENTS);
+    CHECK(statistics.eventToSwap.min() == 1000);
+
+    tracker.reset();
+    statistics = tracker.statistics();
+    CHECK(statistics.droppedEvents == 0);
+    CHECK(statistics.eventToSwap.count() == 0);
+    CHECK(statistics.frameInterval.count() == 0);
+}
+
+}
+
+int main()
+{
+    testAttribution();
+    testPercentiles();
+    testTimerConversion();
+    testEventAfterSwapTime();
+    testPendingEventsLimit();
+
+    if(failures)
+    {
+        std::cerr << failures << " checks failed\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,173 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "utf8.h"
+
+namespace
+{
+
+int failures = 0;
+
+#define CHECK(condition) \
+    if(!(condition)) \
+    { \
+        std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #condition "\n"; \
+        ++failures; \
+    }
+
+// A straightforward encoder the optimized one is compared with
+std::string reference(const std::vector<uint32_t>& codepoints)
+{
+    std::string result;
+    for(uint32_t codepoint : codepoints)
+    {
+        if((codepoint >= 0xD800 && codepoint <= 0xDFFF) || codepoint > 0x10FFFF)
+        {
+            codepoint = 0xFFFD;
+        }
+        if(codepoint < 0x80)
+        {
+            result += static_cast<char>(codepoint);
+        }
+        else if(codepoint < 0x800)
+        {
+            result += static_cast<char>(0xC0 | codepoint >> 6);
+            result += static_cast<char>(0x80 | (codepoint & 0x3F));
+        }
+        else if(codepoint < 0x10000)
+        {
+            result += static_cast<char>(0xE0 | codepoint >> 12);
+            result += static_cast<char>(0x80 | (codepoint >> 6 & 0x3F));
+            result += static_cast<char>(0x80 | (codepoint & 0x3F));
+        }
+        else
+        {
+            result += static_cast<char>(0xF0 | codepoint >> 18);
+            result += static_cast<char>(0x80 | (codepoint >> 12 & 0x3F));
+            result += static_cast<char>(0x80 | (codepoint >> 6 & 0x3F));
+            result += static_cast<char>(0x80 | (codepoint & 0x3F));
+        }
+    }
+    return result;
+}
+
+std::string encode(const std::vector<uint32_t>& codepoints)
+{
+    // Guard bytes after the documented room catch writes past it
+    const size_t room = codepoints.size() * glfwW::UTF8_MAX_BYTES;
+    std::string buffer(room + 16, '#');
+    const size_t size = glfwW::encodeUtf8(codepoints.data(), codepoints.size(), &buffer[0]);
+    if(size > room || buffer.compare(room, 16, std::string(16, '#')) != 0)
+    {
+        return "overflow";
+    }
+    return buffer.substr(0, size);
+}
+
+bool matchesReference(const std::vector<uint32_t>& codepoints)
+{
+    return encode(codepoints) == reference(codepoints);
+}
+
+void testAscii()
+{
+    for(const size_t length : {0, 1, 7, 8, 9, 15, 16, 17, 64, 67})
+    {
+        std::vector<uint32_t> codepoints(length);
+        for(size_t i = 0; i < length; ++i)
+        {
+            codepoints[i] = static_cast<uint32_t>(i * 37 % 128);
+        }
+        CHECK(matchesReference(codepoints));
+    }
+}
+
+void testMixedBlocks()
+{
+    // One non-ASCII codepoint at every position of a few blocks, with ASCII blocks before and after
+    const uint32_t others[] = {0x80, 0x7FF, 0x800, 0xFFFF, 0x10000, 0x10FFFF, 0xFFFD};
+    for(const uint32_t other : others)
+    {
+        for(size_t position = 0; position < 27; ++position)
+        {
+            std::vector<uint32_t> codepoints(27, 'a');
+            codepoints[position] = other;
+            CHECK(matchesReference(codepoints));
+        }
+    }
+
+    std::vector<uint32_t> alternating;
+    for(uint32_t i = 0; i < 101; ++i)
+    {
+        alternating.push_back(i % 3 ? 'x' : 0x400 + i);
+    }
+    CHECK(matchesReference(alternating));
+}
+
+void testInvalidCodepoints()
+{
+    const std::string replacement = "\xEF\xBF\xBD";
+    for(const uint32_t invalid : {0xD800u, 0xDBFFu, 0xDC00u, 0xDFFFu, 0x110000u, 0x7FFFFFFFu, 0x80000000u, 0xFFFFFFFFu})
+    {
+        CHECK(encode({invalid}) == replacement);
+        // Values which look negative or saturate the packs must not pass as ASCII in a block
+        std::vector<uint32_t> block(8, 'b');
+        block[5] = invalid;
+        CHECK(encode(block) == "bbbbb" + replacement + "bb");
+    }
+    CHECK(encode({0xD7FF}) == "\xED\x9F\xBF");
+    CHECK(encode({0xE000}) == "\xEE\x80\x80");
+    CHECK(encode({0x10FFFF}) == "\xF4\x8F\xBF\xBF");
+}
+
+void testRandom()
+{
+    uint32_t state = 12345;
+    const auto next = [&state]{
+        state = state * 1664525u + 1013904223u;
+        return state;
+    };
+    for(int round = 0; round < 200; ++round)
+    {
+        std::vector<uint32_t> codepoints(next() % 100);
+        for(auto& codepoint : codepoints)
+        {
+            // Mostly ASCII with occasional values from the whole 32-bit range
+            const uint32_t value = next();
+            codepoint = value % 16 ? value >> 25 : next();
+        }
+        CHECK(matchesReference(codepoints));
+    }
+}
+
+void testString()
+{
+    std::string text;
+    text.reserve(256);
+    const auto capacity = text.capacity();
+    const std::vector<uint32_t> codepoints = {'h', 0xE9, 'l', 'l', 0x20AC, 0x1F600};
+    glfwW::encodeUtf8(codepoints.data(), codepoints.size(), text);
+    CHECK(text == reference(codepoints));
+    CHECK(text.capacity() == capacity);
+    glfwW::encodeUtf8(codepoints.data(), 0, text);
+    CHECK(text.empty());
+}
+
+}
+
+int main()
+{
+    testAscii();
+    testMixedBlocks();
+    testInvalidCodepoints();
+    testRandom();
+    testString();
+
+    if(failures)
+    {
+        std::cerr << failures << " checks failed\n";
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
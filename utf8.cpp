@@ -0,0 +1,91 @@
+#include "utf8.h"
+
+// GLFWW_NO_SIMD builds the scalar path only, e.g. to test it against the SSE2 one
+#if !defined(GLFWW_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define GLFWW_UTF8_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace glfwW
+{
+
+namespace
+{
+
+constexpr uint32_t REPLACEMENT_CHARACTER = 0xFFFD;
+
+char* encodeCodepoint(uint32_t codepoint, char* out)
+{
+    if(codepoint < 0x80)
+    {
+        *out++ = static_cast<char>(codepoint);
+        return out;
+    }
+    if(codepoint < 0x800)
+    {
+        *out++ = static_cast<char>(0xC0 | (codepoint >> 6));
+        *out++ = static_cast<char>(0x80 | (codepoint & 0x3F));
+        return out;
+    }
+    if((codepoint >= 0xD800 && codepoint <= 0xDFFF) || codepoint > 0x10FFFF)
+    {
+        codepoint = REPLACEMENT_CHARACTER;
+    }
+    if(codepoint < 0x10000)
+    {
+        *out++ = static_cast<char>(0xE0 | (codepoint >> 12));
+        *out++ = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (codepoint & 0x3F));
+        return out;
+    }
+    *out++ = static_cast<char>(0xF0 | (codepoint >> 18));
+    *out++ = static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+    *out++ = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+    *out++ = static_cast<char>(0x80 | (codepoint & 0x3F));
+    return out;
+}
+
+}
+
+size_t encodeUtf8(const uint32_t* codepoints, size_t count, char* out)
+{
+    char* const begin = out;
+    size_t i = 0;
+#ifdef GLFWW_UTF8_SSE2
+    const __m128i nonAsciiMask = _mm_set1_epi32(~0x7F);
+    const __m128i zero = _mm_setzero_si128();
+    while(i + 8 <= count)
+    {
+        const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(codepoints + i));
+        const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(codepoints + i + 4));
+        const __m128i nonAscii = _mm_and_si128(_mm_or_si128(low, high), nonAsciiMask);
+        if(_mm_movemask_epi8(_mm_cmpeq_epi32(nonAscii, zero)) != 0xFFFF)
+        {
+            // Encode up to the end of this block one by one, then try the fast path again
+            for(const size_t end = i + 8; i < end; ++i)
+            {
+                out = encodeCodepoint(codepoints[i], out);
+            }
+            continue;
+        }
+        // All values are below 0x80, so the saturating packs narrow them to bytes unchanged
+        const __m128i words = _mm_packs_epi32(low, high);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(words, words));
+        out += 8;
+        i += 8;
+    }
+#endif
+    for(; i < count; ++i)
+    {
+        out = encodeCodepoint(codepoints[i], out);
+    }
+    return static_cast<size_t>(out - begin);
+}
+
+void encodeUtf8(const uint32_t* codepoints, size_t count, std::string& text)
+{
+    text.resize(count * UTF8_MAX_BYTES);
+    text.resize(encodeUtf8(codepoints, count, &text[0]));
+}
+
+}
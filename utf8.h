@@ -0,0 +1,30 @@
+#ifndef GLFWW_UTF8_H
+#define GLFWW_UTF8_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace glfwW
+{
+
+/*!
+ * \brief The longest UTF-8 encoding of a codepoint in bytes
+ */
+constexpr size_t UTF8_MAX_BYTES = 4;
+
+/*!
+ * \brief Encodes codepoints as UTF-8 and returns the number of bytes written.
+ * out must have room for count * UTF8_MAX_BYTES bytes. Surrogates and values above U+10FFFF are replaced with U+FFFD.
+ * Runs of ASCII are encoded 8 codepoints at a time with SSE2 where it is available.
+ */
+size_t encodeUtf8(const uint32_t* codepoints, size_t count, char* out);
+
+/*!
+ * \brief Encodes codepoints as UTF-8, replacing the contents of text. The capacity of text is reused.
+ */
+void encodeUtf8(const uint32_t* codepoints, size_t count, std::string& text);
+
+}
+
+#endif
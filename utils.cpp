@@ -1,11 +1,44 @@
 #include "utils.h"
+#include <cctype>
+
+#ifndef GLFWW_INLINE_HOT_PATH
+#include "utils.inl"
+#endif
 
 namespace glfwW
 {
 
-bool fromGLFWBool(int val)
+std::string trim(const std::string& text)
+{
+    const auto begin = text.find_first_not_of(" \t\r");
+    if(begin == std::string::npos)
+    {
+        return std::string();
+    }
+    const auto end = text.find_last_not_of(" \t\r");
+    return text.substr(begin, end - begin + 1);
+}
+
+bool equalNames(const std::string& text, const char* name)
 {
-    return val == GLFW_TRUE;
+    size_t i = 0;
+    for(const char* c = name; *c; ++c)
+    {
+        while(i < text.size() && (text[i] == '_' || text[i] == ' '))
+        {
+            ++i;
+        }
+        if(i == text.size() || std::tolower(static_cast<unsigned char>(text[i])) != std::tolower(static_cast<unsigned char>(*c)))
+        {
+            return false;
+        }
+        ++i;
+    }
+    while(i < text.size() && (text[i] == '_' || text[i] == ' '))
+    {
+        ++i;
+    }
+    return i == text.size();
 }
 
 }
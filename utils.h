@@ -1,6 +1,7 @@
 #ifndef GLFWW_UTILS_H
 #define GLFWW_UTILS_H
 
+#include <string>
 #include <vector>
 #include "monitor.h"
 #include "window.h"
@@ -8,8 +9,22 @@
 namespace glfwW
 {
 
-bool fromGLFWBool(int val);
+GLFWW_CONSTEXPR bool fromGLFWBool(int val);
+
+/*!
+ * \brief Returns the text without leading and trailing spaces, tabs and carriage returns.
+ */
+std::string trim(const std::string& text);
+
+/*!
+ * \brief Compares a name ignoring case, underscores and spaces, so "page_up" and "Page Up" match "PageUp".
+ */
+bool equalNames(const std::string& text, const char* name);
 
 }
 
+#ifdef GLFWW_INLINE_HOT_PATH
+#include "utils.inl"
+#endif
+
 #endif
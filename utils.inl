@@ -0,0 +1,16 @@
+#ifndef GLFWW_UTILS_INL
+#define GLFWW_UTILS_INL
+
+#include "utils.h"
+
+namespace glfwW
+{
+
+GLFWW_CONSTEXPR bool fromGLFWBool(int val)
+{
+    return val == GLFW_TRUE;
+}
+
+}
+
+#endif
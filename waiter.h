@@ -0,0 +1,199 @@
+#ifndef GLFWW_WAITER_H
+#define GLFWW_WAITER_H
+
+namespace glfwW
+{
+
+template<typename Event>
+class WaiterList;
+
+/*!
+ * \brief A link of an intrusive circular list. A waiter unlinks itself in constant time from whatever list holds it,
+ * including the batch a WaiterList is resuming.
+ */
+class WaiterLink
+{
+public:
+    WaiterLink() = default;
+    WaiterLink(const WaiterLink&) = delete;
+    WaiterLink& operator=(const WaiterLink&) = delete;
+
+protected:
+    template<typename Event>
+    friend class WaiterList;
+
+    bool linked() const {return m_next != nullptr;}
+
+    // Makes the link an empty list
+    void makeEmpty()
+    {
+        m_previous = this;
+        m_next = this;
+    }
+
+    void linkBefore(WaiterLink& position)
+    {
+        m_previous = position.m_previous;
+        m_next = &position;
+        m_previous->m_next = this;
+        position.m_previous = this;
+    }
+
+    void unlink()
+    {
+        m_previous->m_next = m_next;
+        m_next->m_previous = m_previous;
+        m_previous = nullptr;
+        m_next = nullptr;
+    }
+
+    // Moves all links of the list headed by other into this empty list
+    void takeAll(WaiterLink& other)
+    {
+        if(other.m_next == &other)
+        {
+            makeEmpty();
+            return;
+        }
+        m_next = other.m_next;
+        m_previous = other.m_previous;
+        m_next->m_previous = this;
+        m_previous->m_next = this;
+        other.makeEmpty();
+    }
+
+    WaiterLink* m_previous = nullptr;
+    WaiterLink* m_next = nullptr;
+};
+
+/*!
+ * \brief A one-shot awaitable for the next event of a source.
+ * The awaiter lives in the awaiting coroutine's frame and is linked into the source's list, so awaiting doesn't allocate.
+ * The coroutine is resumed from the dispatch path of the event. If the source goes away first, the coroutine is
+ * resumed with a default-constructed event and cancelled() returns true.
+ * ! The interface is C++17, co_await needs C++20.
+ */
+template<typename Event>
+class EventAwaiter: private WaiterLink
+{
+public:
+    explicit EventAwaiter(WaiterList<Event>* list): m_list(list) {}
+    EventAwaiter(const EventAwaiter&) = delete;
+    EventAwaiter& operator=(const EventAwaiter&) = delete;
+
+    ~EventAwaiter()
+    {
+        // Also unlinks from a batch being resumed, e.g. when another resumed coroutine destroys this one
+        if(linked())
+        {
+            unlink();
+        }
+    }
+
+    bool cancelled() const {return m_list == nullptr;}
+
+    bool await_ready() const {return m_list == nullptr;}
+
+    template<typename Handle>
+    void await_suspend(Handle handle)
+    {
+        m_coroutine = handle.address();
+        m_resume = [](void* coroutine){Handle::from_address(coroutine).resume();};
+        m_list->push(*this);
+    }
+
+    Event await_resume() const {return m_event;}
+
+private:
+    friend class WaiterList<Event>;
+
+    WaiterList<Event>* m_list = nullptr;
+    void* m_coroutine = nullptr;
+    void(* m_resume)(void*) = nullptr;
+    Event m_event = Event();
+};
+
+/*!
+ * \brief An intrusive list of coroutines waiting for an event, resumed in the order they started waiting.
+ */
+template<typename Event>
+class WaiterList
+{
+public:
+    WaiterList()
+    {
+        m_waiters.makeEmpty();
+    }
+
+    WaiterList(const WaiterList&) = delete;
+    WaiterList& operator=(const WaiterList&) = delete;
+
+    ~WaiterList()
+    {
+        while(!empty())
+        {
+            auto& waiter = front(m_waiters);
+            waiter.unlink();
+            waiter.m_list = nullptr;
+        }
+    }
+
+    bool empty() const {return m_waiters.m_next == &m_waiters;}
+
+    /*!
+     * \brief Resumes all current waiters with the event. Coroutines which wait again are resumed by the next event.
+     */
+    void notify(const Event& event)
+    {
+        resumeAll(&event);
+    }
+
+    /*!
+     * \brief Resumes all current waiters as cancelled.
+     */
+    void cancel()
+    {
+        resumeAll(nullptr);
+    }
+
+private:
+    friend class EventAwaiter<Event>;
+
+    static EventAwaiter<Event>& front(WaiterLink& list)
+    {
+        return static_cast<EventAwaiter<Event>&>(*list.m_next);
+    }
+
+    void push(EventAwaiter<Event>& waiter)
+    {
+        waiter.linkBefore(m_waiters);
+    }
+
+    void resumeAll(const Event* event)
+    {
+        // The waiters are moved into a batch on the stack first: resumed coroutines may wait again,
+        // destroy other waiting coroutines or destroy the source
+        WaiterLink batch;
+        batch.takeAll(m_waiters);
+        while(batch.m_next != &batch)
+        {
+            auto& waiter = front(batch);
+            waiter.unlink();
+            if(event)
+            {
+                waiter.m_event = *event;
+            }
+            else
+            {
+                waiter.m_list = nullptr;
+            }
+            waiter.m_resume(waiter.m_coroutine);
+        }
+    }
+
+    WaiterLink m_waiters;
+};
+
+}
+
+#endif
@@ -1,6 +1,11 @@
 #include "window.h"
 #include "glfwlibrary.h"
 #include "utils.h"
+#include "utf8.h"
+
+#ifndef GLFWW_INLINE_HOT_PATH
+#include "window.inl"
+#endif
 
 namespace glfwW
 {
@@ -90,6 +95,18 @@ ContextReleaseBehavior toContextReleaseBehavior(int value)
     return ContextReleaseBehavior::ANY_RELEASE_BEHAVIOR;
 }
 
+int bytesPerPixel(PixelFormat format)
+{
+    switch(format)
+    {
+    case PixelFormat::RGBA:
+        return 4;
+    case PixelFormat::RGB:
+        return 3;
+    }
+    return 4;
+}
+
 void WindowCreationHints::clear()
 {
     m_boolHints.clear();
@@ -103,6 +120,93 @@ void WindowCreationHints::resetToDefault()
     glfwDefaultWindowHints();
 }
 
+Error WindowCreationHints::validate() const
+{
+    auto invalid = [](const char* description)
+    {
+        Error error;
+        error.code = ErrorCode::INVALID_VALUE;
+        error.description = description;
+        return error;
+    };
+
+    const ClientAPI api = m_clientAPI.value_or(ClientAPI::OPENGL);
+    if(api == ClientAPI::NO_API)
+    {
+        return Error();
+    }
+
+    const int major = intHint(WindowHint::CONTEXT_VERSION_MAJOR, 1);
+    const int minor = intHint(WindowHint::CONTEXT_VERSION_MINOR, 0);
+    if(api == ClientAPI::OPENGL_ES)
+    {
+        if(major < 1 || minor < 0 || (major == 1 && minor > 1) || (major == 2 && minor > 0))
+        {
+            return invalid("Invalid OpenGL ES version");
+        }
+        return Error();
+    }
+
+    if(major < 1 || minor < 0 || (major == 1 && minor > 5) || (major == 2 && minor > 1) || (major == 3 && minor > 3))
+    {
+        return invalid("Invalid OpenGL version");
+    }
+    if(m_openGlProfile.value_or(OpenGLProfile::OPENGL_ANY_PROFILE) != OpenGLProfile::OPENGL_ANY_PROFILE &&
+       (major <= 2 || (major == 3 && minor < 2)))
+    {
+        return invalid("Context profiles are only defined for OpenGL version 3.2 and above");
+    }
+    if(boolHint(WindowHint::OPENGL_FORWARD_COMPAT, false) && major <= 2)
+    {
+        return invalid("Forward-compatibility is only defined for OpenGL version 3.0 and above");
+    }
+    return Error();
+}
+
+void WindowCreationHints::merge(const WindowCreationHints& other)
+{
+    for(const auto& hint : other.m_boolHints)
+    {
+        m_boolHints[hint.first] = hint.second;
+    }
+    for(const auto& hint : other.m_intHints)
+    {
+        m_intHints[hint.first] = hint.second;
+    }
+    if(other.m_clientAPI)
+    {
+        m_clientAPI = other.m_clientAPI;
+    }
+    if(other.m_contextCreationAPI)
+    {
+        m_contextCreationAPI = other.m_contextCreationAPI;
+    }
+    if(other.m_openGlProfile)
+    {
+        m_openGlProfile = other.m_openGlProfile;
+    }
+    if(other.m_contextRobustness)
+    {
+        m_contextRobustness = other.m_contextRobustness;
+    }
+    if(other.m_contextReleaseBehavior)
+    {
+        m_contextReleaseBehavior = other.m_contextReleaseBehavior;
+    }
+}
+
+int WindowCreationHints::intHint(WindowHint hint, int defaultValue) const
+{
+    auto itr = m_intHints.find(hint);
+    return itr != m_intHints.end() ? itr->second : defaultValue;
+}
+
+bool WindowCreationHints::boolHint(WindowHint hint, bool defaultValue) const
+{
+    auto itr = m_boolHints.find(hint);
+    return itr != m_boolHints.end() ? itr->second : defaultValue;
+}
+
 void WindowCreationHints::apply() const
 {
     std::for_each(m_boolHints.cbegin(), m_boolHints.cend(), [this](const std::pair<WindowHint, bool>& hint){
@@ -341,10 +445,16 @@ std::unordered_map<GLFWwindow*, Window::RestoreHandler> Window::restoreHandlers;
 std::unordered_map<GLFWwindow*, Window::FocusHandler> Window::focusHandlers;
 std::unordered_map<GLFWwindow*, Window::KeyHandler> Window::keyHandlers;
 std::unordered_map<GLFWwindow*, Window::TextHandler> Window::textHandlers;
+std::unordered_map<GLFWwindow*, Window::TextBatch> Window::textBatches;
+std::vector<GLFWwindow*> Window::pendingTextBatches;
+std::unordered_map<GLFWwindow*, LatencyTracker> Window::latencyTrackers;
 std::unordered_map<GLFWwindow*, Window::CursorPositionChangesHandler> Window::cursorPositionChangeHandlers;
 std::unordered_map<GLFWwindow*, Window::CursorEnterHandler> Window::cursorEnterHandlers;
 std::unordered_map<GLFWwindow*, Window::MouseClickHandler> Window::mouseClickHandlers;
 std::unordered_map<GLFWwindow*, Window::ScrollHandler> Window::scrollHandlers;
+std::unordered_map<GLFWwindow*, Cursor> Window::cursors;
+std::unordered_map<GLFWwindow*, WaiterList<KeyEvent>> Window::keyWaiters;
+std::unordered_map<GLFWwindow*, WaiterList<MouseButtonEvent>> Window::mouseClickWaiters;
 
 void windowCloseCallback(GLFWwindow* window)
 {
@@ -404,6 +514,7 @@ void windowMaximizeCallback(GLFWwindow* window, int maximized)
 
 void windowFocusCallback(GLFWwindow* window, int focused)
 {
+    GLFWlibrary::instance().onWindowFocus(window, focused == GLFW_TRUE);
     Window(window, Window::WindowOwnership::None).onFocused(focused);
 }
 
@@ -474,9 +585,16 @@ Window::~Window()
         focusHandlers.erase(m_window);
         keyHandlers.erase(m_window);
         textHandlers.erase(m_window);
+        textBatches.erase(m_window);
+        latencyTrackers.erase(m_window);
         cursorPositionChangeHandlers.erase(m_window);
         cursorEnterHandlers.erase(m_window);
         mouseClickHandlers.erase(m_window);
+        cursors.erase(m_window);
+        cancelWaiters(keyWaiters, m_window);
+        cancelWaiters(mouseClickWaiters, m_window);
+        onContextDestroyed(m_window);
+        GLFWlibrary::instance().onWindowDestroyed(m_window);
 
         glfwDestroyWindow(m_window);
     }
@@ -582,6 +700,18 @@ void Window::setTextHandler(TextHandler h) const
     glfwSetCharCallback(m_window, textCallback);
 }
 
+void Window::setTextBatchHandler(TextBatchHandler h) const
+{
+    assert(m_window);
+    if(!h)
+    {
+        textBatches.erase(m_window);
+        return;
+    }
+    textBatches[m_window].handler = h;
+    glfwSetCharCallback(m_window, textCallback);
+}
+
 void Window::setCursorPositionChangesHandler(CursorPositionChangesHandler h) const
 {
     assert(m_window);
@@ -610,35 +740,80 @@ void Window::setScrollHandler(ScrollHandler h) const
     glfwSetScrollCallback(m_window, scrollCallback);
 }
 
-bool Window::shouldClose() const
+void Window::setLatencyTracking(bool enabled) const
 {
-    return m_window && glfwWindowShouldClose(m_window);
+    assert(m_window);
+    if(!enabled)
+    {
+        latencyTrackers.erase(m_window);
+        return;
+    }
+    if(latencyTrackers.find(m_window) != latencyTrackers.end())
+    {
+        return;
+    }
+    latencyTrackers.emplace(std::piecewise_construct, std::forward_as_tuple(m_window), std::forward_as_tuple(glfwGetTimerFrequency()));
+    // The callbacks are needed to see the events even if the window has no handlers for them
+    glfwSetKeyCallback(m_window, keyCallback);
+    glfwSetMouseButtonCallback(m_window, mouseButtonCallback);
+    glfwSetCursorPosCallback(m_window, cursorPositionCallback);
+    glfwSetScrollCallback(m_window, scrollCallback);
 }
 
-void Window::setShouldClose(bool val) const
+bool Window::getLatencyTracking() const
 {
-    if(m_window)
+    return latencyTrackers.find(m_window) != latencyTrackers.end();
+}
+
+LatencyStatistics Window::getLatencyStatistics() const
+{
+    auto itr = latencyTrackers.find(m_window);
+    return itr != latencyTrackers.end() ? itr->second.statistics() : LatencyStatistics();
+}
+
+void Window::resetLatencyStatistics() const
+{
+    auto itr = latencyTrackers.find(m_window);
+    if(itr != latencyTrackers.end())
     {
-        glfwSetWindowShouldClose(m_window, val ? GLFW_TRUE : GLFW_FALSE);
+        itr->second.reset();
     }
 }
 
-void Window::setSize(Vec2<int> size) const
+EventAwaiter<KeyEvent> Window::nextKey() const
+{
+    if(!m_window)
+    {
+        return EventAwaiter<KeyEvent>(nullptr);
+    }
+    glfwSetKeyCallback(m_window, keyCallback);
+    return EventAwaiter<KeyEvent>(&keyWaiters[m_window]);
+}
+
+EventAwaiter<MouseButtonEvent> Window::nextClick() const
+{
+    if(!m_window)
+    {
+        return EventAwaiter<MouseButtonEvent>(nullptr);
+    }
+    glfwSetMouseButtonCallback(m_window, mouseButtonCallback);
+    return EventAwaiter<MouseButtonEvent>(&mouseClickWaiters[m_window]);
+}
+
+void Window::setShouldClose(bool val) const
 {
     if(m_window)
     {
-        glfwSetWindowSize(m_window, size.x, size.y);
+        glfwSetWindowShouldClose(m_window, val ? GLFW_TRUE : GLFW_FALSE);
     }
 }
 
-Vec2<int> Window::getSize() const
+void Window::setSize(Vec2<int> size) const
 {
-    Vec2<int> result;
     if(m_window)
     {
-        glfwGetWindowSize(m_window, &result.x, &result.y);
+        glfwSetWindowSize(m_window, size.x, size.y);
     }
-    return result;
 }
 
 FrameSize Window::getFrameSize() const
@@ -700,16 +875,6 @@ void Window::setCurrentSizeAsAspectRatio()
     }
 }
 
-Vec2<int> Window::getFramebufferSize() const
-{
-    Vec2<int> result;
-    if(m_window)
-    {
-        glfwGetFramebufferSize(m_window, &result.x, &result.y);
-    }
-    return result;
-}
-
 Vec2<float> Window::getContentScale() const
 {
     Vec2<float> result;
@@ -720,16 +885,6 @@ Vec2<float> Window::getContentScale() const
     return result;
 }
 
-Vec2<int> Window::getPosition() const
-{
-    Vec2<int> result;
-    if(m_window)
-    {
-        glfwGetWindowPos(m_window, &result.x, &result.y);
-    }
-    return result;
-}
-
 void Window::setPosition(Vec2<int> position)
 {
     if(m_window)
@@ -754,6 +909,11 @@ void Window::setIcon(const std::vector<GLFWimage>& icons)
     }
 }
 
+void Window::setIcon(const IconSet& icons)
+{
+    setIcon(icons.images());
+}
+
 bool Window::isFullscreen() const
 {
     return  m_window && glfwGetWindowMonitor(m_window);
@@ -928,22 +1088,33 @@ void Window::setUserPointer(void* ptr) const
     glfwSetWindowUserPointer(m_window, ptr);
 }
 
-void* Window::getUserPointer() const
+size_t Window::getFramebufferByteSize(PixelFormat format) const
 {
-    return glfwGetWindowUserPointer(m_window);
+    const auto size = getFramebufferSize();
+    return static_cast<size_t>(size.x) * static_cast<size_t>(size.y) * bytesPerPixel(format);
 }
 
-void Window::swapBuffers() const
+bool Window::readPixels(PixelFormat format, void* buffer, size_t bufferSize) const
 {
-    if(m_window)
-    {
-        glfwSwapBuffers(m_window);
-    }
+    return readPixels({{0, 0}, getFramebufferSize()}, format, buffer, bufferSize);
 }
 
-Action Window::getKeyAction(Key key) const
+bool Window::readPixels(Rect<int> area, PixelFormat format, void* buffer, size_t bufferSize) const
 {
-    return fromGlfwAction(glfwGetKey(m_window, toGlfwKey(key)));
+    const size_t required = static_cast<size_t>(area.size.x) * static_cast<size_t>(area.size.y) * bytesPerPixel(format);
+    if(!m_window || !buffer || area.size.x <= 0 || area.size.y <= 0 || bufferSize < required)
+    {
+        return false;
+    }
+    assert(isContextCurrent(m_window));
+
+    GLint packAlignment = 4;
+    glGetIntegerv(GL_PACK_ALIGNMENT, &packAlignment);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(area.position.x, area.position.y, area.size.x, area.size.y,
+                 format == PixelFormat::RGBA ? GL_RGBA : GL_RGB, GL_UNSIGNED_BYTE, buffer);
+    glPixelStorei(GL_PACK_ALIGNMENT, packAlignment);
+    return true;
 }
 
 bool Window::getStickyKeysMode() const
@@ -972,27 +1143,32 @@ void Window::setLockModifiersAvailable(bool val)
     }
 }
 
-Vec2<double> Window::getCursorPos() const
+void Window::setCursorMode(CursorMode val)
 {
-    Vec2<double> result;
     if(m_window)
     {
-        glfwGetCursorPos(m_window, &result.x, &result.y);
+        glfwSetInputMode(m_window, GLFW_CURSOR, toGlfwCursorMode(val));
     }
-    return result;
 }
 
-CursorMode Window::getCursorMode() const
+void Window::setCursor(const Cursor& cursor)
 {
-    return fromGlfwCursorMode(glfwGetInputMode(m_window, GLFW_CURSOR));
+    if(!m_window)
+    {
+        return;
+    }
+    auto& current = cursors[m_window];
+    if(current != cursor)
+    {
+        current = cursor;
+        glfwSetCursor(m_window, cursor.getHandler());
+    }
 }
 
-void Window::setCursorMode(CursorMode val)
+Cursor Window::getCursor() const
 {
-    if(m_window)
-    {
-        glfwSetInputMode(m_window, GLFW_CURSOR, toGlfwCursorMode(val));
-    }
+    auto itr = cursors.find(m_window);
+    return itr != cursors.end() ? itr->second : Cursor();
 }
 
 bool Window::getRawMouseMotionMode() const
@@ -1078,16 +1254,29 @@ void Window::onFocused(bool focused) const
 
 void Window::onKeyEvent(KeyEvent event) const
 {
+    trackInputLatency();
     tryInvokeCallback(keyHandlers, event);
+    tryResumeWaiters(keyWaiters, event);
 }
 
 void Window::onText(unsigned int codepoint) const
 {
     tryInvokeCallback(textHandlers, codepoint);
+    auto itr = textBatches.find(m_window);
+    if(itr != textBatches.end())
+    {
+        auto& codepoints = itr->second.codepoints;
+        if(codepoints.empty())
+        {
+            pendingTextBatches.push_back(m_window);
+        }
+        codepoints.push_back(codepoint);
+    }
 }
 
 void Window::onCursorPositionChanged(Vec2<double> pos) const
 {
+    trackInputLatency();
     tryInvokeCallback(cursorPositionChangeHandlers, pos);
 }
 
@@ -1098,14 +1287,70 @@ void Window::onCursorEntered(bool entered) const
 
 void Window::onMouseButton(MouseButtonEvent buttonEvent)
 {
+    trackInputLatency();
     tryInvokeCallback(mouseClickHandlers, buttonEvent);
+    tryResumeWaiters(mouseClickWaiters, buttonEvent);
 }
 
 void Window::onScroll(Vec2<double> offset)
 {
+    trackInputLatency();
     tryInvokeCallback(scrollHandlers, offset);
 }
 
+void Window::trackInputLatency() const
+{
+    if(latencyTrackers.empty())
+    {
+        return;
+    }
+    auto itr = latencyTrackers.find(m_window);
+    if(itr != latencyTrackers.end())
+    {
+        itr->second.onEvent(glfwGetTimerValue());
+    }
+}
+
+void Window::trackSwapLatency() const
+{
+    auto itr = latencyTrackers.find(m_window);
+    if(itr != latencyTrackers.end())
+    {
+        itr->second.onSwap(glfwGetTimerValue());
+    }
+}
+
+void Window::flushTextBatches()
+{
+    if(pendingTextBatches.empty())
+    {
+        return;
+    }
+
+    // Handlers may receive more text or destroy windows, so they work on a list of their own
+    std::vector<GLFWwindow*> windows;
+    windows.swap(pendingTextBatches);
+    for(auto window : windows)
+    {
+        auto itr = textBatches.find(window);
+        if(itr == textBatches.end() || itr->second.codepoints.empty())
+        {
+            continue;
+        }
+        auto& batch = itr->second;
+        encodeUtf8(batch.codepoints.data(), batch.codepoints.size(), batch.text);
+        batch.codepoints.clear();
+        std::invoke(batch.handler, Window(window, WindowOwnership::None), std::string_view(batch.text));
+    }
+
+    // Keep the capacity for the next events
+    if(pendingTextBatches.empty())
+    {
+        windows.clear();
+        pendingTextBatches.swap(windows);
+    }
+}
+
 int Window::glfwWindowAttributeValue(WindowAttribute attribute) const
 {
     switch(attribute)
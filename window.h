@@ -8,8 +8,16 @@
 #include "monitor.h"
 #include <functional>
 #include <optional>
+#include <string>
+#include <string_view>
 #include <vector>
 #include "events.h"
+#include "context.h"
+#include "errors.h"
+#include "icon.h"
+#include "latency.h"
+#include "metrics.h"
+#include "waiter.h"
 #include "mouse.h"
 
 namespace glfwW
@@ -181,6 +189,20 @@ struct FrameSize
     int bottom = 0;
 };
 
+/*!
+ * \brief The layout of pixels read back from a framebuffer
+ */
+enum class PixelFormat
+{
+    RGBA,
+    RGB
+};
+
+/*!
+ * \brief Returns the number of bytes a single pixel of the format occupies.
+ */
+int bytesPerPixel(PixelFormat format);
+
 class WindowCreationHints
 {
 public:
@@ -201,7 +223,7 @@ public:
         {
             m_clientAPI = value;
         }
-        else if constexpr(std::is_same_v<T, ClientAPI>)
+        else if constexpr(std::is_same_v<T, ContextCreationAPI>)
         {
             m_contextCreationAPI = value;
         }
@@ -222,11 +244,24 @@ public:
 
     void clear();
 
+    /*!
+     * \brief Checks the context hints the way glfwCreateWindow does, without creating anything:
+     * the OpenGL or OpenGL ES version, the profile and forward compatibility. Unset hints take GLFW defaults.
+     */
+    Error validate() const;
+
 private:
     friend class GLFWlibrary;
 
     static void resetToDefault();
 
+    /*!
+     * \brief Overrides the hints with the ones set in other.
+     */
+    void merge(const WindowCreationHints& other);
+    int intHint(WindowHint hint, int defaultValue) const;
+    bool boolHint(WindowHint hint, bool defaultValue) const;
+
     void apply() const;
     void applyHint(WindowHint hint, bool value) const;
     void applyHint(WindowHint hint, int value) const;
@@ -375,6 +410,7 @@ public:
     using FocusHandler = std::function<void(const Window&, bool)>;
     using KeyHandler = std::function<void(const Window&, KeyEvent)>;
     using TextHandler = std::function<void(const Window&, unsigned int)>;
+    using TextBatchHandler = std::function<void(const Window&, std::string_view)>;
     using CursorPositionChangesHandler = std::function<void(const Window&, Vec2<double>)>;
     using CursorEnterHandler = std::function<void(const Window&, bool)>;
     using MouseClickHandler = std::function<void(const Window&, MouseButtonEvent)>;
@@ -462,6 +498,14 @@ public:
      */
     void setTextHandler(TextHandler h) const;
 
+    /*!
+     * \brief Sets a callback for text input delivered in batches. The codepoints received during one call of
+     * GLFWlibrary::pollEvents (waitEvents, waitEventsTimeout) are delivered as a single UTF-8 string after it,
+     * so pasted text and input committed by an IME arrive at once. The string is valid only during the call.
+     * The handler can be used together with the one set by setTextHandler.
+     */
+    void setTextBatchHandler(TextBatchHandler h) const;
+
     /*!
      * \brief Sets a callback for cursor position changes. The callback is notified when the cursor moves over the window.
      */
@@ -482,6 +526,18 @@ public:
      */
     void setScrollHandler(ScrollHandler h) const;
 
+    // AWAITABLE EVENTS
+    /*!
+     * \brief Returns an awaitable for the next key event: co_await window.nextKey().
+     * The coroutine is resumed after the key handler. It is resumed as cancelled if the window is destroyed first.
+     */
+    EventAwaiter<KeyEvent> nextKey() const;
+
+    /*!
+     * \brief Returns an awaitable for the next mouse button event: co_await window.nextClick().
+     */
+    EventAwaiter<MouseButtonEvent> nextClick() const;
+
     //WINDOW CLOSING
     /*!
      * \brief Returns true if the wrapper is valid and the window should be closed.
@@ -579,6 +635,11 @@ public:
      */
     void setIcon(const std::vector<GLFWimage>& icons);
 
+    /*!
+     * \brief Sets icons generated by an icon set. The set's images are passed to GLFW without copies.
+     */
+    void setIcon(const IconSet& icons);
+
     // FULLSCREEN \ WINDOWED
     // !Full screen windows are associated with a specific monitor.
     /*!
@@ -761,18 +822,57 @@ public:
      */
     void swapBuffers() const;
 
+    /*!
+     * \brief Enables latency measurement. Key, mouse button, cursor and scroll events are timestamped on arrival
+     * with glfwGetTimerValue and attributed to the next swapBuffers() call. Disabled by default.
+     */
+    void setLatencyTracking(bool enabled) const;
+
+    bool getLatencyTracking() const;
+
+    /*!
+     * \brief Returns event-to-swap latencies and frame intervals in microseconds, or empty statistics if
+     * latency tracking is disabled.
+     */
+    LatencyStatistics getLatencyStatistics() const;
+
+    void resetLatencyStatistics() const;
+
+    /*!
+     * \brief Returns the number of bytes required to read back the whole framebuffer in the given format.
+     */
+    size_t getFramebufferByteSize(PixelFormat format) const;
+
+    /*!
+     * \brief Reads the framebuffer of the window directly into caller-provided memory.
+     * Rows are tightly packed and stored bottom-up, as OpenGL returns them.
+     * ! The window's context has to be current. For double buffered windows call it before swapBuffers().
+     * Returns false if the window is invalid or the buffer is too small.
+     */
+    bool readPixels(PixelFormat format, void* buffer, size_t bufferSize) const;
+
+    /*!
+     * \brief Reads an area of the framebuffer (in pixels, origin at the bottom-left corner) into caller-provided memory.
+     */
+    bool readPixels(Rect<int> area, PixelFormat format, void* buffer, size_t bufferSize) const;
+
     // CONTEXT
     /*!
-     * \brief Make window's OpenGL context current for a thread.
+     * \brief Make window's OpenGL context current for a thread. Does nothing if it is current already.
      */
     void activate() const
     {
         if(m_window)
         {
-            glfwMakeContextCurrent(m_window);
+            makeContextCurrent(m_window);
         }
     }
 
+    /*!
+     * \brief Returns true if the window's context is current on the calling thread.
+     */
+    bool isActive() const {return isContextCurrent(m_window);}
+
     // KEY INPUT
     /*!
      * \brief Returns the last reported state for the key.
@@ -807,9 +907,25 @@ public:
      */
     Vec2<double> getCursorPos() const;
 
+    /*!
+     * \brief Returns the last reported state for the mouse button, PRESS or RELEASE.
+     */
+    Action getMouseButtonAction(MouseButton button) const;
+
     CursorMode getCursorMode() const;
     void setCursorMode(CursorMode val);
 
+    /*!
+     * \brief Sets the cursor image used while the cursor is over the content area. An invalid cursor restores the default arrow.
+     * Setting the cursor which is already set does nothing.
+     */
+    void setCursor(const Cursor& cursor);
+
+    /*!
+     * \brief Returns the cursor set by setCursor().
+     */
+    Cursor getCursor() const;
+
     /*!
      * \brief Returns true if raw mouse motion can be obtained in DISABLE mode.
      */
@@ -838,10 +954,33 @@ private:
         auto itr = callbacksContainer.find(m_window);
         if (itr != callbacksContainer.end())
         {
+            MetricsTimer timer(Metrics::instance().callbackDispatch);
             std::invoke(itr->second, *this, std::forward<Args>(args)...);
         }
     }
 
+    template<typename Event>
+    void tryResumeWaiters(std::unordered_map<GLFWwindow*, WaiterList<Event>>& waitersContainer, const Event& event) const
+    {
+        auto itr = waitersContainer.find(m_window);
+        if (itr != waitersContainer.end())
+        {
+            itr->second.notify(event);
+        }
+    }
+
+    template<typename Event>
+    static void cancelWaiters(std::unordered_map<GLFWwindow*, WaiterList<Event>>& waitersContainer, GLFWwindow* window)
+    {
+        auto itr = waitersContainer.find(window);
+        if (itr != waitersContainer.end())
+        {
+            itr->second.cancel();
+            // Cancelled coroutines may have changed the container, so the entry is erased by key
+            waitersContainer.erase(window);
+        }
+    }
+
     void onClose() const;
     void onSizeChanged(int width, int height) const;
     void onFramebufferSizeChanged(int width, int height) const;
@@ -860,6 +999,21 @@ private:
     void onScroll(Vec2<double> offset);
     int glfwWindowAttributeValue(WindowAttribute attribute) const;
 
+    /*!
+     * \brief Delivers the text accumulated by batch handlers. Called by GLFWlibrary after processing events.
+     */
+    static void flushTextBatches();
+
+    void trackInputLatency() const;
+    void trackSwapLatency() const;
+
+    struct TextBatch
+    {
+        TextBatchHandler handler;
+        std::vector<uint32_t> codepoints;
+        std::string text;
+    };
+
     GLFWwindow* m_window = nullptr;
 
     static std::unordered_map<GLFWwindow*, CloseHandler> closeHandlers;
@@ -874,14 +1028,24 @@ private:
     static std::unordered_map<GLFWwindow*, FocusHandler> focusHandlers;
     static std::unordered_map<GLFWwindow*, KeyHandler> keyHandlers;
     static std::unordered_map<GLFWwindow*, TextHandler> textHandlers;
+    static std::unordered_map<GLFWwindow*, TextBatch> textBatches;
+    static std::vector<GLFWwindow*> pendingTextBatches;
+    static std::unordered_map<GLFWwindow*, LatencyTracker> latencyTrackers;
     static std::unordered_map<GLFWwindow*, CursorPositionChangesHandler> cursorPositionChangeHandlers;
     static std::unordered_map<GLFWwindow*, CursorEnterHandler> cursorEnterHandlers;
     static std::unordered_map<GLFWwindow*, MouseClickHandler> mouseClickHandlers;
     static std::unordered_map<GLFWwindow*, ScrollHandler> scrollHandlers;
+    static std::unordered_map<GLFWwindow*, Cursor> cursors;
+    static std::unordered_map<GLFWwindow*, WaiterList<KeyEvent>> keyWaiters;
+    static std::unordered_map<GLFWwindow*, WaiterList<MouseButtonEvent>> mouseClickWaiters;
 
     WindowOwnership m_ownership = WindowOwnership::None;
 };
 
 }
 
+#ifdef GLFWW_INLINE_HOT_PATH
+#include "window.inl"
+#endif
+
 #endif
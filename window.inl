@@ -0,0 +1,91 @@
+#ifndef GLFWW_WINDOW_INL
+#define GLFWW_WINDOW_INL
+
+#include "window.h"
+
+namespace glfwW
+{
+
+GLFWW_INLINE bool Window::shouldClose() const
+{
+    return m_window && glfwWindowShouldClose(m_window);
+}
+
+GLFWW_INLINE Vec2<int> Window::getSize() const
+{
+    Vec2<int> result;
+    if(m_window)
+    {
+        glfwGetWindowSize(m_window, &result.x, &result.y);
+    }
+    return result;
+}
+
+GLFWW_INLINE Vec2<int> Window::getFramebufferSize() const
+{
+    Vec2<int> result;
+    if(m_window)
+    {
+        glfwGetFramebufferSize(m_window, &result.x, &result.y);
+    }
+    return result;
+}
+
+GLFWW_INLINE Vec2<int> Window::getPosition() const
+{
+    Vec2<int> result;
+    if(m_window)
+    {
+        glfwGetWindowPos(m_window, &result.x, &result.y);
+    }
+    return result;
+}
+
+GLFWW_INLINE Vec2<double> Window::getCursorPos() const
+{
+    Vec2<double> result;
+    if(m_window)
+    {
+        glfwGetCursorPos(m_window, &result.x, &result.y);
+    }
+    return result;
+}
+
+GLFWW_INLINE Action Window::getKeyAction(Key key) const
+{
+    return fromGlfwAction(glfwGetKey(m_window, toGlfwKey(key)));
+}
+
+GLFWW_INLINE Action Window::getMouseButtonAction(MouseButton button) const
+{
+    return fromGlfwAction(glfwGetMouseButton(m_window, toGlfwMouseButton(button)));
+}
+
+GLFWW_INLINE CursorMode Window::getCursorMode() const
+{
+    return fromGlfwCursorMode(glfwGetInputMode(m_window, GLFW_CURSOR));
+}
+
+GLFWW_INLINE void* Window::getUserPointer() const
+{
+    return glfwGetWindowUserPointer(m_window);
+}
+
+GLFWW_INLINE void Window::swapBuffers() const
+{
+    if(m_window)
+    {
+        {
+            MetricsTimer timer(Metrics::instance().bufferSwap);
+            glfwSwapBuffers(m_window);
+        }
+        if(!latencyTrackers.empty())
+        {
+            trackSwapLatency();
+        }
+    }
+}
+
+}
+
+#endif